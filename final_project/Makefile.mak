@@ -1,19 +1,41 @@
 CXX = g++
-CXXFLAGS = -Wall
+CXXFLAGS = -Wall -O2 -pthread
+
+# the solver itself is a static library, other tools link against libcdcl.a and include solver.h
+LIB_SRCS = solver.cpp
+LIB_OBJS = $(LIB_SRCS:.cpp=.o)
+LIB_TARGET = libcdcl.a
 
 SRCS = cdcl.cpp
 OBJS = $(SRCS:.cpp=.o)
 TARGET = cdcl
 
-.PHONY: all clean
+BENCH_SRCS = bench.cpp
+BENCH_OBJS = $(BENCH_SRCS:.cpp=.o)
+BENCH_TARGET = bench
+
+.PHONY: all clean check
 
 all: $(TARGET)
 
-$(TARGET): $(OBJS)
-	$(CXX) $(CXXFLAGS) $(OBJS) -o $(TARGET)
+$(LIB_TARGET): $(LIB_OBJS)
+	$(AR) rcs $(LIB_TARGET) $(LIB_OBJS)
+
+$(TARGET): $(OBJS) $(LIB_TARGET)
+	$(CXX) $(CXXFLAGS) $(OBJS) $(LIB_TARGET) -o $(TARGET)
+
+# benchmark harness, run it as ./bench [--baseline <csv>] [--out <csv>] next to the cdcl binary
+$(BENCH_TARGET): $(BENCH_OBJS) $(TARGET)
+	$(CXX) $(CXXFLAGS) $(BENCH_OBJS) -o $(BENCH_TARGET)
+
+# regression tests against brute force and an independent proof checker, needs python3
+check: $(TARGET)
+	sh tests/run_tests.sh ./$(TARGET)
+
+$(OBJS) $(LIB_OBJS): solver.h
 
 %.o: %.cpp
 	$(CXX) $(CXXFLAGS) -c $< -o $@
 
 clean:
-	$(RM) $(OBJS) $(TARGET)
+	$(RM) $(OBJS) $(TARGET) $(LIB_OBJS) $(LIB_TARGET) $(BENCH_OBJS) $(BENCH_TARGET)
@@ -0,0 +1,439 @@
+// benchmark harness for the cdcl solver                                                //
+// generates instances of several families over a sweep of sizes, runs the solver on    //
+// each of them as a child process and reports one CSV line per run:                   //
+// family,size,seed,variables,clauses,result,time_s,peak_rss_kb,conflicts,              //
+// conflicts_per_sec,props_per_sec                                                       //
+// with --baseline <csv> the times of an earlier run are added for comparison           //
+// with --threads 1,2,4,... every instance is solved once per thread count and the       //
+// scaling against the first count is added, e.g. --solver-args --cube --threads 1,...,64 //
+// this only provides the harness, no multi-core results are recorded with the repo, and //
+// counts above the host's cores measure oversubscription rather than scaling            //
+#include <vector>
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include <cstring>
+#include <csignal>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+// builds a CNF formula in DIMACS numbering, with Tseitin gates for the circuit families //
+class CnfBuilder {
+  private:
+    int numVariables;
+    std::vector<std::vector<int>> clauses;
+  public:
+    CnfBuilder() : numVariables(0) {}
+
+    int newVariable() {
+      return ++numVariables;
+    }
+
+    void addClause(const std::vector<int>& clause) {
+      clauses.push_back(clause);
+    }
+
+    int andGate(int a, int b) {
+      int out = newVariable();
+      addClause({-out, a});
+      addClause({-out, b});
+      addClause({out, -a, -b});
+      return out;
+    }
+
+    int orGate(int a, int b) {
+      return -andGate(-a, -b);
+    }
+
+    int xorGate(int a, int b) {
+      int out = newVariable();
+      addClause({-out, a, b});
+      addClause({-out, -a, -b});
+      addClause({out, -a, b});
+      addClause({out, a, -b});
+      return out;
+    }
+
+    int getNumVariables() const {
+      return numVariables;
+    }
+
+    int getNumClauses() const {
+      return clauses.size();
+    }
+
+    bool write(const std::string& filename) const {
+      std::ofstream file(filename);
+      if (!file.is_open()) {
+        return false;
+      }
+      file << "p cnf " << numVariables << " " << clauses.size() << "\n";
+      for (const auto& clause : clauses) {
+        for (int lit : clause) {
+          file << lit << " ";
+        }
+        file << "0\n";
+      }
+      return file.good();
+    }
+};
+
+// random k-SAT close to the satisfiability threshold of k //
+void randomKSat(CnfBuilder& cnf, int n, int k, std::mt19937& rng) {
+  double ratio = k == 2 ? 1.0 : k == 3 ? 4.26 : k == 4 ? 9.93 : 21.12;
+  std::vector<int> vars(n);
+  for (int i = 0; i < n; ++i) {
+    vars[i] = cnf.newVariable();
+  }
+  int m = (int)(ratio * n);
+  for (int c = 0; c < m; ++c) {
+    std::vector<int> clause;
+    while ((int)clause.size() < k) {
+      int var = vars[rng() % n];
+      if (std::find(clause.begin(), clause.end(), var) == clause.end() &&
+          std::find(clause.begin(), clause.end(), -var) == clause.end()) {
+        clause.push_back(rng() % 2 ? var : -var);
+      }
+    }
+    cnf.addClause(clause);
+  }
+}
+
+// n + 1 pigeons in n holes, always unsatisfiable //
+void pigeonhole(CnfBuilder& cnf, int n) {
+  std::vector<std::vector<int>> p(n + 1, std::vector<int>(n));
+  for (int i = 0; i <= n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      p[i][j] = cnf.newVariable();
+    }
+  }
+  for (int i = 0; i <= n; ++i) {
+    cnf.addClause(p[i]); // every pigeon sits in a hole //
+  }
+  for (int j = 0; j < n; ++j) {
+    for (int i = 0; i <= n; ++i) {
+      for (int k = i + 1; k <= n; ++k) {
+        cnf.addClause({-p[i][j], -p[k][j]}); // no two pigeons share a hole //
+      }
+    }
+  }
+}
+
+// two XOR chains over the same n inputs, in random orders, forced to different //
+// values: unsatisfiable, and hard for resolution once the orders differ         //
+void parityChains(CnfBuilder& cnf, int n, std::mt19937& rng) {
+  std::vector<int> inputs(n);
+  for (int i = 0; i < n; ++i) {
+    inputs[i] = cnf.newVariable();
+  }
+  std::vector<int> order = inputs;
+  std::shuffle(order.begin(), order.end(), rng);
+  int chain1 = inputs[0];
+  int chain2 = order[0];
+  for (int i = 1; i < n; ++i) {
+    chain1 = cnf.xorGate(chain1, inputs[i]);
+    chain2 = cnf.xorGate(chain2, order[i]);
+  }
+  cnf.addClause({chain1});
+  cnf.addClause({-chain2});
+}
+
+// miter of two n-bit adders: a ripple carry adder with majority carries and one //
+// with generate/propagate carries. Unsatisfiable since the adders are equal     //
+void adderMiter(CnfBuilder& cnf, int n) {
+  std::vector<int> a(n), b(n);
+  for (int i = 0; i < n; ++i) {
+    a[i] = cnf.newVariable();
+    b[i] = cnf.newVariable();
+  }
+  std::vector<int> diffs;
+  int carry1 = 0, carry2 = 0; // 0: constant false carry in //
+  for (int i = 0; i < n; ++i) {
+    // adder 1: sum = a ^ b ^ c, carry = ab + ac + bc //
+    int axb = cnf.xorGate(a[i], b[i]);
+    int sum1 = carry1 ? cnf.xorGate(axb, carry1) : axb;
+    int ab = cnf.andGate(a[i], b[i]);
+    int next1 = carry1 ? cnf.orGate(ab, cnf.orGate(cnf.andGate(a[i], carry1), cnf.andGate(b[i], carry1))) : ab;
+    // adder 2: propagate p = a ^ b, generate g = ab, sum = p ^ c, carry = g + pc //
+    int p = cnf.xorGate(a[i], b[i]);
+    int g = cnf.andGate(a[i], b[i]);
+    int sum2 = carry2 ? cnf.xorGate(p, carry2) : p;
+    int next2 = carry2 ? cnf.orGate(g, cnf.andGate(p, carry2)) : g;
+    diffs.push_back(cnf.xorGate(sum1, sum2));
+    carry1 = next1;
+    carry2 = next2;
+  }
+  diffs.push_back(cnf.xorGate(carry1, carry2));
+  cnf.addClause(diffs); // some output differs //
+}
+
+struct RunResult {
+  std::string result;
+  double time;
+  long peakRssKb;
+  long long conflicts;
+  long long conflictsPerSec;
+  long long propsPerSec;
+};
+
+// value of key=... in the solver summary, or 0 //
+long long statValue(const std::string& output, const std::string& key) {
+  size_t pos = output.find(" " + key + "=");
+  if (pos == std::string::npos) {
+    return 0;
+  }
+  return std::atoll(output.c_str() + pos + key.size() + 2);
+}
+
+// run the solver on one file, with a wall clock limit //
+RunResult runSolver(const std::string& solver, const std::vector<std::string>& solverArgs, const std::string& filename,
+                    double timeout) {
+  RunResult run = {"error", 0, 0, 0, 0, 0};
+  int fds[2];
+  if (pipe(fds) != 0) {
+    return run;
+  }
+  auto start = std::chrono::steady_clock::now();
+  pid_t pid = fork();
+  if (pid == 0) {
+    dup2(fds[1], STDOUT_FILENO);
+    close(fds[0]);
+    close(fds[1]);
+    std::vector<char*> args;
+    args.push_back(const_cast<char*>(solver.c_str()));
+    args.push_back(const_cast<char*>("-q"));
+    for (const std::string& arg : solverArgs) {
+      args.push_back(const_cast<char*>(arg.c_str()));
+    }
+    args.push_back(const_cast<char*>(filename.c_str()));
+    args.push_back(nullptr);
+    execv(solver.c_str(), args.data());
+    _exit(127);
+  }
+  close(fds[1]);
+  fcntl(fds[0], F_SETFL, O_NONBLOCK);
+  std::string output;
+  char buffer[1 << 16];
+  int status = 0;
+  struct rusage usage;
+  bool timedOut = false;
+  while (true) {
+    ssize_t n;
+    while ((n = read(fds[0], buffer, sizeof(buffer))) > 0) {
+      output.append(buffer, n);
+    }
+    pid_t done = wait4(pid, &status, WNOHANG, &usage);
+    if (done == pid) {
+      break;
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (!timedOut && elapsed > timeout) {
+      kill(pid, SIGKILL);
+      timedOut = true;
+    }
+    usleep(1000);
+  }
+  ssize_t n;
+  while ((n = read(fds[0], buffer, sizeof(buffer))) > 0) {
+    output.append(buffer, n);
+  }
+  close(fds[0]);
+  run.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  run.peakRssKb = usage.ru_maxrss;
+  if (timedOut) {
+    run.result = "timeout";
+  } else if (output.find("Formula is unsatisfiable.") != std::string::npos) {
+    run.result = "unsat";
+  } else if (output.find("Satisfying assignment:") != std::string::npos) {
+    run.result = "sat";
+  }
+  run.conflicts = statValue(output, "conflicts");
+  run.conflictsPerSec = statValue(output, "conflicts_per_sec");
+  run.propsPerSec = statValue(output, "props_per_sec");
+  return run;
+}
+
+// times of an earlier run, keyed by family,size,seed //
+std::map<std::string, double> readBaseline(const std::string& filename) {
+  std::map<std::string, double> times;
+  std::ifstream file(filename);
+  std::string line;
+  while (std::getline(file, line)) {
+    std::vector<std::string> fields;
+    std::stringstream stream(line);
+    std::string field;
+    while (std::getline(stream, field, ',')) {
+      fields.push_back(field);
+    }
+    if (fields.size() >= 7 && fields[0] != "family") {
+      times[fields[0] + "," + fields[1] + "," + fields[2]] = std::atof(fields[6].c_str());
+    }
+  }
+  return times;
+}
+
+std::vector<int> parseSizes(const std::string& list) {
+  std::vector<int> sizes;
+  std::stringstream stream(list);
+  std::string size;
+  while (std::getline(stream, size, ',')) {
+    sizes.push_back(std::atoi(size.c_str()));
+  }
+  return sizes;
+}
+
+int main(int argc, char *argv[]) {
+  std::string solver = "./cdcl";
+  std::string baselineFile;
+  std::string outputFile;
+  std::vector<std::string> families = {"random3sat", "pigeonhole", "parity", "adder"};
+  std::map<std::string, std::vector<int>> sizes = {
+    {"random3sat", {50, 100, 150, 200, 250}},
+    {"pigeonhole", {5, 6, 7, 8, 9}},
+    {"parity", {8, 12, 16, 20, 24}},
+    {"adder", {4, 8, 16, 32, 64}},
+  };
+  std::vector<std::string> solverArgs;
+  std::vector<int> threadCounts;
+  int seeds = 3;
+  double timeout = 60;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--solver" && i + 1 < argc) {
+      solver = argv[++i];
+    } else if (arg == "--family" && i + 1 < argc) {
+      families = {argv[++i]};
+    } else if (arg == "--sizes" && i + 1 < argc) {
+      std::vector<int> list = parseSizes(argv[++i]);
+      for (auto& entry : sizes) {
+        entry.second = list;
+      }
+    } else if (arg == "--seeds" && i + 1 < argc) {
+      seeds = std::atoi(argv[++i]);
+    } else if (arg == "--timeout" && i + 1 < argc) {
+      timeout = std::atof(argv[++i]);
+    } else if (arg == "--baseline" && i + 1 < argc) {
+      baselineFile = argv[++i];
+    } else if (arg == "--out" && i + 1 < argc) {
+      outputFile = argv[++i];
+    } else if (arg == "--solver-args" && i + 1 < argc) {
+      std::stringstream stream(argv[++i]);
+      std::string word;
+      while (stream >> word) {
+        solverArgs.push_back(word);
+      }
+    } else if (arg == "--threads" && i + 1 < argc) {
+      threadCounts = parseSizes(argv[++i]);
+    } else {
+      std::cerr << "Usage: " << argv[0] << " [--solver <path>] [--family random3sat|pigeonhole|parity|adder]"
+                << " [--sizes n1,n2,...] [--seeds <n>] [--timeout <seconds>] [--baseline <csv>] [--out <csv>]"
+                << " [--solver-args \"<arguments>\"] [--threads t1,t2,...]" << std::endl;
+      return 1;
+    }
+  }
+  for (const auto& family : families) {
+    if (sizes.find(family) == sizes.end()) {
+      std::cerr << "Unknown family: " << family << std::endl;
+      return 1;
+    }
+  }
+
+  std::map<std::string, double> baseline;
+  if (!baselineFile.empty()) {
+    baseline = readBaseline(baselineFile);
+  }
+  std::ofstream outFile;
+  if (!outputFile.empty()) {
+    outFile.open(outputFile);
+  }
+  std::ostream& out = outputFile.empty() ? std::cout : outFile;
+
+  char dirTemplate[] = "/tmp/cdcl_bench_XXXXXX";
+  if (mkdtemp(dirTemplate) == nullptr) {
+    std::cerr << "Unable to create a directory for the instances" << std::endl;
+    return 1;
+  }
+  std::string instance = std::string(dirTemplate) + "/instance.cnf";
+
+  out << "family,size,seed,variables,clauses,result,time_s,peak_rss_kb,conflicts,conflicts_per_sec,props_per_sec";
+  if (!baseline.empty()) {
+    out << ",baseline_time_s,speedup";
+  }
+  if (!threadCounts.empty()) {
+    out << ",threads,scaling";
+  }
+  out << std::endl;
+  unsigned cores = std::thread::hardware_concurrency();
+  for (int threads : threadCounts) {
+    if (cores > 0 && threads > static_cast<int>(cores)) {
+      std::cerr << "Warning: " << threads << " threads on " << cores
+                << " cores, the scaling column will not show a speedup" << std::endl;
+      break;
+    }
+  }
+  if (threadCounts.empty()) {
+    threadCounts.push_back(0); // a single run with the solver's own thread setting //
+  }
+  for (const auto& family : families) {
+    for (int size : sizes[family]) {
+      // the circuit families do not depend on the seed except parity //
+      int runs = (family == "random3sat" || family == "parity") ? seeds : 1;
+      for (int seed = 0; seed < runs; ++seed) {
+        std::mt19937 rng(seed * 7919 + size);
+        CnfBuilder cnf;
+        if (family == "random3sat") {
+          randomKSat(cnf, size, 3, rng);
+        } else if (family == "pigeonhole") {
+          pigeonhole(cnf, size);
+        } else if (family == "parity") {
+          parityChains(cnf, size, rng);
+        } else {
+          adderMiter(cnf, size);
+        }
+        if (!cnf.write(instance)) {
+          std::cerr << "Unable to write " << instance << std::endl;
+          return 1;
+        }
+        double firstTime = 0;
+        for (int threads : threadCounts) {
+          std::vector<std::string> args = solverArgs;
+          if (threads > 0) {
+            args.push_back("--threads");
+            args.push_back(std::to_string(threads));
+          }
+          RunResult run = runSolver(solver, args, instance, timeout);
+          out << family << "," << size << "," << seed << "," << cnf.getNumVariables() << "," << cnf.getNumClauses() << ","
+              << run.result << "," << run.time << "," << run.peakRssKb << "," << run.conflicts << ","
+              << run.conflictsPerSec << "," << run.propsPerSec;
+          if (!baseline.empty()) {
+            auto it = baseline.find(family + "," + std::to_string(size) + "," + std::to_string(seed));
+            if (it != baseline.end()) {
+              out << "," << it->second << "," << (run.time > 0 ? it->second / run.time : 0);
+            } else {
+              out << ",,";
+            }
+          }
+          if (threads > 0) {
+            if (firstTime == 0) {
+              firstTime = run.time;
+            }
+            out << "," << threads << "," << (run.time > 0 ? firstTime / run.time : 0);
+          }
+          out << std::endl;
+        }
+      }
+    }
+  }
+  unlink(instance.c_str());
+  rmdir(dirTemplate);
+  return 0;
+}
@@ -0,0 +1,3596 @@
+// athanasia karanika                                                               //
+// the formula parser, the CDCL solver and the portfolio, see solver.h             //
+#include "solver.h"
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <csignal>
+#include <cerrno>
+#include <cmath>
+
+//                                        *************** ClauseVector ******************** //
+
+bool ClauseVector::parseLines(const char* p, const char* end) {
+    while (p < end) {
+        while (p < end && isBlank(*p)) {
+            p++;
+        }
+        if (p + 1 < end && p[0] == '/' && p[1] == '/') {
+            while (p < end && *p != '\n') {
+                p++;
+            }
+        }
+        bool expectLiteral = true;
+        while (p < end && *p != '\n') {
+            if (isBlank(*p)) {
+                p++;
+            } else if (*p == '+') {
+                if (expectLiteral) {
+                    return parseError("literal expected before '+'");
+                }
+                expectLiteral = true;
+                p++;
+            } else if (*p == '<' || *p == '>') {
+                if (expectLiteral) {
+                    return parseError("literal expected before the bound");
+                }
+                if (!parseBound(p, end)) {
+                    return false;
+                }
+            } else {
+                if (!expectLiteral) {
+                    return parseError("'+' expected between literals");
+                }
+                const char* token = p;
+                while (p < end && *p != '+' && *p != '\n' && *p != '<' && *p != '>' && !isBlank(*p)) {
+                    p++;
+                }
+                bool negated = p - token > 3 && std::memcmp(p - 3, "bar", 3) == 0;
+                nameBuffer.assign(token, negated ? p - 3 : p);
+                literals.push_back(mkLit(getVariableIndex(nameBuffer), negated));
+                expectLiteral = false;
+            }
+        }
+        if (literals.size() > clauseStart.back()) {
+            if (expectLiteral) {
+                return parseError("literal expected after '+'");
+            }
+            clauseStart.push_back(literals.size());
+        }
+        p++;
+        lineNumber++;
+    }
+    return true;
+}
+
+bool ClauseVector::parseDimacs(const char* p, const char* end) {
+    while (p < end) {
+        char c = *p;
+        if (c == '\n') {
+            lineNumber++;
+            p++;
+        } else if (isBlank(c)) {
+            p++;
+        } else if (c == 'c' || c == 'p' || c == '%') {
+            if (c == 'p') {
+                const char* header = p;
+                while (p < end && *p != '\n') {
+                    p++;
+                }
+                std::istringstream line(std::string(header, p));
+                std::string word, format;
+                long long numVariables = 0, numClauses = 0;
+                if (!(line >> word >> format >> numVariables >> numClauses) || (format != "cnf" && format != "cnf+")) {
+                    return parseError("bad DIMACS header");
+                }
+                while ((long long)variables.size() < numVariables) {
+                    dimacsVariable(variables.size() + 1);
+                }
+                clauseStart.reserve(clauseStart.size() + numClauses);
+            } else if (c == '%') {
+                break; // end marker of some benchmark files //
+            }
+            while (p < end && *p != '\n') {
+                p++;
+            }
+        } else if (c == '<' || c == '>') {
+            if (literals.size() == clauseStart.back()) {
+                return parseError("literal expected before the bound");
+            }
+            if (!parseBound(p, end)) {
+                return false;
+            }
+        } else {
+            bool negative = (c == '-');
+            if (negative) {
+                p++;
+            }
+            if (p == end || *p < '0' || *p > '9') {
+                return parseError("integer expected");
+            }
+            long long value = 0;
+            while (p < end && *p >= '0' && *p <= '9') {
+                value = value * 10 + (*p - '0');
+                if (value > (1 << 28)) {
+                    return parseError("variable out of range");
+                }
+                p++;
+            }
+            if (value == 0) {
+                clauseStart.push_back(literals.size());
+            } else {
+                literals.push_back(mkLit(dimacsVariable(value), negative));
+            }
+        }
+    }
+    if (literals.size() > clauseStart.back()) {
+        clauseStart.push_back(literals.size()); // last clause without its 0 //
+    }
+    return true;
+}
+
+bool ClauseVector::parseBound(const char*& p, const char* end) {
+    bool atLeast = *p == '>';
+    if (p + 1 == end || p[1] != '=') {
+        return parseError("'<=' or '>=' expected");
+    }
+    p += 2;
+    while (p < end && isBlank(*p)) {
+        p++;
+    }
+    if (p == end || *p < '0' || *p > '9') {
+        return parseError("bound expected");
+    }
+    long long bound = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        bound = bound * 10 + (*p - '0');
+        if (bound > (1 << 28)) {
+            return parseError("bound out of range");
+        }
+        p++;
+    }
+    while (p < end && isBlank(*p)) {
+        p++;
+    }
+    if (p < end && *p != '\n') {
+        return parseError("end of line expected after the bound");
+    }
+    // the literals of the constraint were read as a clause, move them over //
+    size_t first = clauseStart.back();
+    int size = literals.size() - first;
+    if (atLeast) {
+        for (size_t i = first; i < literals.size(); ++i) {
+            literals[i] = litNeg(literals[i]);
+        }
+        bound = size - bound;
+    }
+    addAtMost(literals.data() + first, size, bound);
+    literals.resize(first);
+    return true;
+}
+
+int ClauseVector::dimacsVariable(long long n) {
+    while ((long long)variables.size() < n) {
+        std::string name = "x" + std::to_string(variables.size() + 1);
+        variableTable.emplace(name, variables.size());
+        variables.push_back(Variable(name));
+    }
+    return n - 1;
+}
+
+bool ClauseVector::parseError(const std::string& message) {
+    std::cerr << "Parse error at line " << lineNumber << ": " << message << std::endl;
+    return false;
+}
+
+int ClauseVector::getVariableIndex(const std::string& varName) {
+    auto it = variableTable.find(varName);
+    if (it != variableTable.end()) {
+        return it->second;
+    }
+    variableTable.emplace(varName, variables.size());
+    variables.push_back(Variable(varName));
+    return variables.size() - 1;
+}
+
+int ClauseVector::addVariable(const std::string& varName) {
+    variableTable.emplace(varName, variables.size()); // a name already taken keeps its variable //
+    variables.push_back(Variable(varName));
+    return variables.size() - 1;
+}
+
+void ClauseVector::addClause(const int* lits, int size) {
+    literals.insert(literals.end(), lits, lits + size);
+    clauseStart.push_back(literals.size());
+}
+
+void ClauseVector::addAtMost(const int* lits, int size, int bound) {
+    cardLiterals.insert(cardLiterals.end(), lits, lits + size);
+    cardStart.push_back(cardLiterals.size());
+    cardBounds.push_back(bound);
+}
+
+bool ClauseVector::parse(const char* data, size_t size) {
+    const char* end = data + size;
+    // the first significant line tells the format apart //
+    const char* p = data;
+    while (p < end && (isBlank(*p) || *p == '\n')) {
+        p++;
+    }
+    // a DIMACS line starts with the word c or p, a variable name such as p1 or cx starts the line syntax //
+    bool dimacs = p < end && (*p == 'p' || *p == 'c') && (p + 1 == end || isBlank(p[1]) || p[1] == '\n');
+    lineNumber = 1;
+    return dimacs ? parseDimacs(data, end) : parseLines(data, end);
+}
+
+bool ClauseVector::readClausesFromFile(const std::string& filename) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Unable to open file: " << filename << std::endl;
+        return false;
+    }
+    struct stat info;
+    bool result;
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        void* data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            close(fd);
+            std::cerr << "Unable to map file: " << filename << std::endl;
+            return false;
+        }
+        madvise(data, info.st_size, MADV_SEQUENTIAL);
+        result = parse(static_cast<const char*>(data), info.st_size);
+        munmap(data, info.st_size);
+    } else {
+        // pipes and other streams are read into a buffer //
+        std::vector<char> buffer;
+        char chunk[1 << 16];
+        ssize_t n;
+        while ((n = read(fd, chunk, sizeof(chunk))) > 0) {
+            buffer.insert(buffer.end(), chunk, chunk + n);
+        }
+        result = parse(buffer.data(), buffer.size());
+    }
+    close(fd);
+    return result;
+}
+
+void ClauseVector::print() {
+  for (int i = 0; i < getSize(); ++i) {
+      std::cout << "Clause " << (i + 1) << ": ";
+      for (int j = 0; j < getClauseSize(i); ++j) {
+          std::cout << literalName(getClause(i)[j]);
+          if (j < getClauseSize(i) - 1) {
+              std::cout << " + ";
+          }
+      }
+      std::cout << "\n";
+  }
+  for (int i = 0; i < getNumCardinalities(); ++i) {
+      std::cout << "Cardinality constraint " << (i + 1) << ": ";
+      for (int j = 0; j < getCardinalitySize(i); ++j) {
+          std::cout << literalName(getCardinality(i)[j]);
+          if (j < getCardinalitySize(i) - 1) {
+              std::cout << " + ";
+          }
+      }
+      std::cout << " <= " << getCardinalityBound(i) << "\n";
+  }
+}
+
+//                                        *************** ProofWriter ******************** //
+
+ProofWriter::~ProofWriter() {
+  if (fd >= 0) {
+    close();
+  }
+}
+
+bool ProofWriter::open(const std::string& filename) {
+  fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    std::cerr << "Unable to open proof file: " << filename << std::endl;
+    return false;
+  }
+  flusher = std::thread(&ProofWriter::flushLoop, this);
+  return true;
+}
+
+bool ProofWriter::close() {
+  handOver();
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    closing = true;
+  }
+  ready.notify_one();
+  flusher.join();
+  ::close(fd);
+  fd = -1;
+  return !failed;
+}
+
+void ProofWriter::handOver() {
+  std::unique_lock<std::mutex> guard(lock);
+  done.wait(guard, [&]() { return !pending; });
+  buffer.swap(flushing);
+  flushSize = used;
+  used = 0;
+  pending = true;
+  ready.notify_one();
+}
+
+void ProofWriter::flushLoop() {
+  std::unique_lock<std::mutex> guard(lock);
+  while (true) {
+    ready.wait(guard, [&]() { return pending || closing; });
+    if (!pending) {
+      return;
+    }
+    // the solver only touches flushing again after pending is cleared //
+    guard.unlock();
+    size_t written = 0;
+    while (written < flushSize && !failed) {
+      ssize_t n = write(fd, flushing.data() + written, flushSize - written);
+      if (n < 0 && errno != EINTR) {
+        std::cerr << "Unable to write the proof" << std::endl;
+        failed = true;
+      } else if (n > 0) {
+        written += n;
+      }
+    }
+    guard.lock();
+    bytes += written;
+    pending = false;
+    done.notify_one();
+  }
+}
+
+//                                        *************** LocalSearch ******************** //
+
+void LocalSearch::addClause(const int* lits, int size) {
+  // duplicate literals would break the xor of the true variables //
+  size_t start = literals.size();
+  literals.insert(literals.end(), lits, lits + size);
+  std::sort(literals.begin() + start, literals.end());
+  literals.erase(std::unique(literals.begin() + start, literals.end()), literals.end());
+  for (size_t k = start + 1; k < literals.size(); ++k) {
+    if (literals[k] == litNeg(literals[k - 1])) {
+      literals.resize(start); // tautology //
+      return;
+    }
+  }
+  clauseStart.push_back(literals.size());
+  prepared = false;
+}
+
+void LocalSearch::prepare() {
+  if (prepared) {
+    return;
+  }
+  prepared = true;
+  int numClauses = clauseStart.size() - 1;
+  occurStart.assign(2 * numVars + 1, 0);
+  size_t longest = 0;
+  for (int c = 0; c < numClauses; ++c) {
+    longest = std::max<size_t>(longest, clauseStart[c + 1] - clauseStart[c]);
+    for (uint32_t k = clauseStart[c]; k < clauseStart[c + 1]; ++k) {
+      occurStart[literals[k] + 1]++;
+    }
+  }
+  for (int l = 0; l < 2 * numVars; ++l) {
+    occurStart[l + 1] += occurStart[l];
+  }
+  occurs.resize(literals.size());
+  std::vector<uint32_t> fill(occurStart.begin(), occurStart.end() - 1);
+  for (int c = 0; c < numClauses; ++c) {
+    for (uint32_t k = clauseStart[c]; k < clauseStart[c + 1]; ++k) {
+      occurs[fill[literals[k]]++] = c;
+    }
+  }
+  weights.resize(longest);
+
+  // the ProbSAT parameters tuned for random k-SAT: polynomial in the break count up to //
+  // three literals per clause on average, exponential above                           //
+  double average = numClauses > 0 ? (double)literals.size() / numClauses : 0;
+  probability.resize(64);
+  for (size_t b = 0; b < probability.size(); ++b) {
+    if (average <= 3.5) {
+      probability[b] = std::pow(0.9 + b, -2.06);
+    } else {
+      probability[b] = std::pow(average <= 4.5 ? 3.0 : average <= 5.5 ? 3.7 : 5.1, -(double)b);
+    }
+  }
+}
+
+int LocalSearch::run(std::vector<char>& assignment, long long maxFlips) {
+  prepare();
+  int numClauses = clauseStart.size() - 1;
+  assignment.resize(numVars, 0);
+  values.assign(assignment.begin(), assignment.end());
+  breaks.assign(numVars, 0);
+  trueCount.assign(numClauses, 0);
+  trueVars.assign(numClauses, 0);
+  unsat.clear();
+  unsatIndex.assign(numClauses, -1);
+  for (int c = 0; c < numClauses; ++c) {
+    for (uint32_t k = clauseStart[c]; k < clauseStart[c + 1]; ++k) {
+      int var = litVar(literals[k]);
+      if (values[var] != litSign(literals[k])) {
+        trueCount[c]++;
+        trueVars[c] ^= var;
+      }
+    }
+    if (trueCount[c] == 0) {
+      unsatIndex[c] = unsat.size();
+      unsat.push_back(c);
+    } else if (trueCount[c] == 1) {
+      breaks[trueVars[c]]++;
+    }
+  }
+
+  size_t best = unsat.size();
+  sinceBest.clear();
+  odd.assign(numVars, 0);
+  for (long long i = 0; i < maxFlips && !unsat.empty(); ++i) {
+    uint32_t clause = unsat[randomGenerator() % unsat.size()];
+    if (clauseStart[clause] == clauseStart[clause + 1]) {
+      break; // an empty clause stays unsatisfied //
+    }
+    int var = options.walkAlgorithm == WALK_WALKSAT ? pickWalkSat(clause) : pickProbSat(clause);
+    flip(var);
+    flips++;
+    sinceBest.push_back(var);
+    if (unsat.size() < best) {
+      best = unsat.size();
+      for (int v : sinceBest) {
+        assignment[v] ^= 1;
+      }
+      sinceBest.clear();
+    } else if (sinceBest.size() > 2 * (size_t)numVars + 1024) {
+      // only the variables flipped an odd number of times differ from the best assignment //
+      for (int v : sinceBest) {
+        odd[v] ^= 1;
+      }
+      sinceBest.clear();
+      for (int v = 0; v < numVars; ++v) {
+        if (odd[v]) {
+          odd[v] = 0;
+          sinceBest.push_back(v);
+        }
+      }
+    }
+  }
+  return best;
+}
+
+void LocalSearch::flip(int var) {
+  int becomesTrue = mkLit(var, values[var]);
+  values[var] ^= 1;
+  for (uint32_t k = occurStart[becomesTrue]; k < occurStart[becomesTrue + 1]; ++k) {
+    uint32_t c = occurs[k];
+    if (trueCount[c]++ == 0) {
+      int index = unsatIndex[c];
+      unsat[index] = unsat.back();
+      unsatIndex[unsat[index]] = index;
+      unsat.pop_back();
+      unsatIndex[c] = -1;
+      trueVars[c] = var;
+      breaks[var]++;
+    } else {
+      if (trueCount[c] == 2) {
+        breaks[trueVars[c]]--; // no longer the only true variable //
+      }
+      trueVars[c] ^= var;
+    }
+  }
+  int becomesFalse = litNeg(becomesTrue);
+  for (uint32_t k = occurStart[becomesFalse]; k < occurStart[becomesFalse + 1]; ++k) {
+    uint32_t c = occurs[k];
+    if (--trueCount[c] == 0) {
+      unsatIndex[c] = unsat.size();
+      unsat.push_back(c);
+      trueVars[c] = 0;
+      breaks[var]--;
+    } else {
+      trueVars[c] ^= var;
+      if (trueCount[c] == 1) {
+        breaks[trueVars[c]]++;
+      }
+    }
+  }
+}
+
+int LocalSearch::pickProbSat(uint32_t clause) {
+  int size = clauseStart[clause + 1] - clauseStart[clause];
+  const int* lits = literals.data() + clauseStart[clause];
+  double sum = 0;
+  for (int k = 0; k < size; ++k) {
+    int b = std::min<int>(breaks[litVar(lits[k])], probability.size() - 1);
+    weights[k] = probability[b];
+    sum += weights[k];
+  }
+  double r = sum * (randomGenerator() / 4294967296.0);
+  for (int k = 0; k < size - 1; ++k) {
+    r -= weights[k];
+    if (r < 0) {
+      return litVar(lits[k]);
+    }
+  }
+  return litVar(lits[size - 1]);
+}
+
+int LocalSearch::pickWalkSat(uint32_t clause) {
+  int size = clauseStart[clause + 1] - clauseStart[clause];
+  const int* lits = literals.data() + clauseStart[clause];
+  int bestVar = litVar(lits[0]);
+  for (int k = 0; k < size; ++k) {
+    int var = litVar(lits[k]);
+    if (breaks[var] == 0) {
+      return var;
+    }
+    if (breaks[var] < breaks[bestVar]) {
+      bestVar = var;
+    }
+  }
+  if (randomGenerator() % 1000 < 567) {
+    return litVar(lits[randomGenerator() % size]);
+  }
+  return bestVar;
+}
+
+//                                        *************** CDCLSolver ******************** //
+
+CDCLSolver::CDCLSolver(std::vector<Variable>& vars, const SolverOptions& opts)
+    : options(opts), variables(vars), binaryClauses(0), nextBinarySimplify(1), ok(true), qhead(0), binaryHead(0),
+      binaryConflictLit(-1), cardHead(0), simplifyAssigns(0), varInc(1.0), orderHeap(activity),
+      randomGenerator(opts.seed), claInc(1.0), stamp(0), nextReduce(opts.reduceFirst), nextProgress(opts.progressInterval),
+      conflictsSinceRestart(0), sumLbd(0), exportRing(nullptr), stopFlag(nullptr), conflictLimit(-1), proof(nullptr),
+      nextWalk(1), walkPropagations(0) {
+  searchStart = wallTime();
+  recentLbds.init(options.glucoseWindow);
+  growVariables();
+}
+
+CDCLSolver::CDCLSolver(const ClauseVector& clauseVector, std::vector<Variable>& vars, const SolverOptions& opts,
+                       ProofWriter* proofWriter)
+    : CDCLSolver(vars, opts) {
+  proof = proofWriter;
+  loadClauses(clauseVector);
+}
+
+void CDCLSolver::load(const ClauseVector& clauseVector, const std::vector<Variable>& vars) {
+  variables.assign(vars.begin(), vars.end());
+  ok = true;
+  trail.clear();
+  trailLim.clear();
+  qhead = 0;
+  binaryHead = 0;
+  simplifyAssigns = 0;
+  for (auto& ws : watches) {
+    ws.clear();
+  }
+  for (auto& implied : implications) {
+    implied.clear();
+  }
+  binaryClauses = 0;
+  nextBinarySimplify = 1;
+  cardLiterals.clear();
+  cards.clear();
+  for (auto& occurs : cardOccurs) {
+    occurs.clear();
+  }
+  cardHead = 0;
+  assigns.clear();
+  level.clear();
+  reason.clear();
+  seen.clear();
+  activity.clear();
+  levelStamp.clear();
+  polarity.clear();
+  model.clear();
+  orderHeap.clear();
+  arena.clear();
+  clauses.clear();
+  learnts.clear();
+  varInc = 1.0;
+  claInc = 1.0;
+  stamp = 0;
+  randomGenerator.seed(options.seed);
+  stats = SolverStatistics();
+  nextReduce = options.reduceFirst;
+  nextProgress = options.progressInterval;
+  conflictsSinceRestart = 0;
+  recentLbds.clear();
+  sumLbd = 0;
+  assumptions.clear();
+  conflict.clear();
+  conflictLimit = -1;
+  nextWalk = 1;
+  walkPropagations = 0;
+  walkAssignment.clear();
+  searchStart = wallTime();
+  growVariables();
+  loadClauses(clauseVector);
+}
+
+void CDCLSolver::loadClauses(const ClauseVector& clauseVector) {
+  // decide each variable with the polarity that occurs in most clauses //
+  std::vector<int> occurrences(2 * variables.size(), 0);
+  size_t totalLiterals = 0;
+  for (int i = 0; i < clauseVector.getSize(); ++i) {
+    totalLiterals += Clause::words(clauseVector.getClauseSize(i));
+  }
+  arena.reserve(totalLiterals);
+  std::vector<int> clause;
+  for (int i = 0; i < clauseVector.getSize(); ++i) {
+    const int* lits = clauseVector.getClause(i);
+    clause.assign(lits, lits + clauseVector.getClauseSize(i));
+    for (int lit : clause) {
+      occurrences[lit]++;
+    }
+    addClause(clause);
+  }
+  for (int i = 0; i < clauseVector.getNumCardinalities(); ++i) {
+    const int* lits = clauseVector.getCardinality(i);
+    clause.assign(lits, lits + clauseVector.getCardinalitySize(i));
+    for (int lit : clause) {
+      occurrences[litNeg(lit)]++; // an at-most constraint is helped by false literals //
+    }
+    addAtMost(clause, clauseVector.getCardinalityBound(i));
+  }
+  if (options.initialPhase == PHASE_OCCURRENCE) {
+    for (size_t v = 0; v < variables.size(); ++v) {
+      polarity[v] = occurrences[mkLit(v, true)] > occurrences[mkLit(v, false)];
+    }
+  }
+}
+
+bool CDCLSolver::addClause(const std::vector<int>& input) {
+  if (!ok) {
+    return false;
+  }
+  std::vector<int>& lits = addBuffer;
+  lits.assign(input.begin(), input.end());
+  std::sort(lits.begin(), lits.end());
+  size_t j = 0;
+  for (size_t i = 0; i < lits.size(); ++i) {
+    if (litValue(lits[i]) == 1 || (j > 0 && lits[i] == litNeg(lits[j - 1]))) {
+      return true;
+    }
+    if (litValue(lits[i]) == 0 && (j == 0 || lits[i] != lits[j - 1])) {
+      lits[j++] = lits[i];
+    }
+  }
+  lits.resize(j);
+  if (proof != nullptr && lits.size() < input.size()) {
+    proof->addClause(lits); // the clause without its literals false at level 0 //
+  }
+  if (lits.empty()) {
+    ok = false;
+  } else if (lits.size() == 1) {
+    enqueue(lits[0], CREF_UNDEF);
+  } else if (lits.size() == 2) {
+    addBinary(lits[0], lits[1]);
+  } else {
+    CRef ref = arena.alloc(lits.data(), lits.size(), false);
+    clauses.push_back(ref);
+    attachClause(ref);
+  }
+  return ok;
+}
+
+bool CDCLSolver::addAtMost(const std::vector<int>& input, int bound) {
+  if (!ok) {
+    return false;
+  }
+  std::vector<int>& lits = addBuffer;
+  lits.assign(input.begin(), input.end());
+  std::sort(lits.begin(), lits.end());
+  // a literal true at level 0 uses up one of the bound, and a literal next to its //
+  // negation always counts exactly once, so both leave for one less             //
+  size_t j = 0;
+  for (size_t i = 0; i < lits.size(); ++i) {
+    if (litValue(lits[i]) != 0) {
+      bound -= litValue(lits[i]) == 1;
+    } else if (j > 0 && lits[i] == litNeg(lits[j - 1])) {
+      j--;
+      bound--;
+    } else {
+      lits[j++] = lits[i];
+    }
+  }
+  lits.resize(j);
+  int size = lits.size();
+  if (bound < 0) {
+    ok = false;
+  } else if (bound == 0) {
+    for (int lit : lits) {
+      if (litValue(lit) == 0) {
+        enqueue(litNeg(lit), CREF_UNDEF);
+      }
+    }
+  } else if (bound == size - 1) {
+    // not all of them: the clause of the negations //
+    std::vector<int> clause;
+    for (int lit : lits) {
+      clause.push_back(litNeg(lit));
+    }
+    return addClause(clause);
+  } else if (bound < size) {
+    cards.emplace_back(cardLiterals.size(), size, bound);
+    for (int lit : lits) {
+      cardLiterals.push_back(lit);
+      cardOccurs[lit].push_back(cards.size() - 1);
+    }
+  }
+  return ok;
+}
+
+int CDCLSolver::solveLimited(const std::vector<int>& assumps) {
+  cancelUntil(0);
+  searchStart = wallTime();
+  assumptions = assumps;
+  conflict.clear();
+  int result = ok ? search() : -1;
+  stats.searchTime += wallTime() - searchStart;
+  if (result == 1) {
+    // unconstrained variables stay false //
+    model.resize(variables.size());
+    for (size_t v = 0; v < variables.size(); ++v) {
+      model[v] = assigns[v] == 1;
+    }
+  }
+  cancelUntil(0); // back to level 0, ready for addClause //
+  assumptions.clear();
+  return result;
+}
+
+void CDCLSolver::printStatistics() {
+  stats.print(std::cout, "c stats", stats.searchTime);
+  std::cout << "c stats learnt_clauses_kept=" << learnts.size() << " binary_clauses=" << binaryClauses
+            << " cardinality_constraints=" << cards.size() << " cardinality_literals=" << cardLiterals.size()
+            << " arena_words=" << arena.size() << std::endl;
+}
+
+void CDCLSolver::printAssignement() {
+  std::cout << "Satisfying assignment:" << std::endl;
+  for (auto& i : variables) {
+    std::cout << i.getVariable() << ": " << (i.getAssignment() ? "true" : "false") << "\n";
+  }
+  std::cout.flush();
+}
+
+int CDCLSolver::search() {
+  // step 1: unit clauses were assigned at level 0 by addClause and are propagated first //
+  std::vector<int> learnt;
+  while (true) {
+    if ((stopFlag != nullptr && stopFlag->load(std::memory_order_relaxed))
+        || (conflictLimit >= 0 && stats.conflicts >= conflictLimit)) {
+      return 0;
+    }
+    double start = wallTime();
+    CRef conflictClause = propagate();
+    stats.propagateTime += wallTime() - start;
+    if (conflictClause != CREF_UNDEF) {
+      TRACE(options.verbosity, VERBOSITY_TRACE, std::cout << "conflict detected\n");
+      stats.conflicts++;
+      conflictsSinceRestart++;
+      if (decisionLevel() == 0) {
+        ok = false;
+        if (proof != nullptr) {
+          proof->addClause(nullptr, 0);
+        }
+        return -1; // conflict without any decision //
+      }
+      start = wallTime();
+      int backjumpLevel = analyze(conflictClause, learnt);
+      stats.analyzeTime += wallTime() - start;
+      cancelUntil(backjumpLevel);
+      addLearntClause(learnt);
+      varDecayActivity();
+      claDecayActivity();
+      TRACE(options.verbosity, VERBOSITY_TRACE, printDecisionTrail());
+      if (stats.conflicts >= nextProgress) {
+        nextProgress += options.progressInterval;
+        if (options.verbosity >= VERBOSITY_PROGRESS) {
+          printProgress();
+        }
+      }
+      continue;
+    }
+
+    if (restartDue()) {
+      TRACE(options.verbosity, VERBOSITY_INFO,
+            std::cout << "info: restart " << (stats.restarts + 1) << " after " << conflictsSinceRestart << " conflicts\n");
+      cancelUntil(0);
+      stats.restarts++;
+      conflictsSinceRestart = 0;
+      recentLbds.clear();
+      if (options.walk && stats.restarts >= nextWalk) {
+        walk();
+      }
+    }
+    if (decisionLevel() == 0 && !importRings.empty()) {
+      size_t assigned = trail.size();
+      if (!importClauses()) {
+        return -1;
+      }
+      if (trail.size() > assigned) {
+        continue; // propagate the imported units first //
+      }
+    }
+    if (decisionLevel() == 0 && (trail.size() > simplifyAssigns || binaryClauses >= nextBinarySimplify)) {
+      size_t assigned = trail.size();
+      simplify();
+      if (!ok) {
+        return -1;
+      }
+      if (trail.size() > assigned) {
+        continue; // units found by the substitution //
+      }
+    }
+    if (stats.conflicts >= nextReduce) {
+      double start = wallTime();
+      reduceDB();
+      stats.reduceTime += wallTime() - start;
+      nextReduce = stats.conflicts + options.reduceFirst + (long long)options.reduceInc * stats.reductions;
+    }
+
+    // step 2: assignment: the assumptions come first, one level each, then //
+    // the most active unassigned variable                                   //
+    int next = -1;
+    while (decisionLevel() < (int)assumptions.size()) {
+      int p = assumptions[decisionLevel()];
+      if (litValue(p) == 1) {
+        trailLim.push_back(trail.size()); // already holds, the level stays empty //
+      } else if (litValue(p) == -1) {
+        analyzeFinal(litNeg(p));
+        return -1;
+      } else {
+        next = p;
+        break;
+      }
+    }
+    if (next == -1) {
+      next = pickBranchLiteral();
+    }
+    if (next == -1) {
+      TRACE(options.verbosity, VERBOSITY_TRACE, printDecisionTrail());
+      return 1; // every variable is assigned without conflict //
+    }
+    stats.decisions++;
+    trailLim.push_back(trail.size()); // the decision opens a new level //
+    enqueue(next, CREF_UNDEF);
+    TRACE(options.verbosity, VERBOSITY_TRACE, printDecisionTrail());
+  }
+}
+
+bool CDCLSolver::assumeCube(const std::vector<int>& cube) {
+  cancelUntil(0);
+  if (!ok) {
+    return false;
+  }
+  if (propagate() != CREF_UNDEF) {
+    ok = false;
+    return false;
+  }
+  for (int lit : cube) {
+    if (litValue(lit) == 1) {
+      continue;
+    }
+    if (litValue(lit) == -1) {
+      return false;
+    }
+    trailLim.push_back(trail.size());
+    enqueue(lit, CREF_UNDEF);
+    if (propagate() != CREF_UNDEF) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int CDCLSolver::lookahead(int lit) {
+  size_t assigned = trail.size();
+  trailLim.push_back(trail.size());
+  enqueue(lit, CREF_UNDEF);
+  bool failed = propagate() != CREF_UNDEF;
+  int implied = trail.size() - assigned;
+  cancelUntil(decisionLevel() - 1);
+  return failed ? -1 : implied;
+}
+
+int CDCLSolver::analyze(CRef conflictClause, std::vector<int>& learnt) {
+  int pathCount = 0;
+  int p = -1;
+  int index = trail.size() - 1;
+  CRef ref = conflictClause;
+  learnt.clear();
+  learnt.push_back(-1); // room for the asserting literal //
+
+  do {
+    const int* lits;
+    int size;
+    if (p == -1 && isBinaryReason(ref)) {
+      reasonBinary[0] = binaryConflictLit;
+      reasonBinary[1] = binaryReasonLit(ref);
+      lits = reasonBinary;
+      size = 2;
+    } else if (p == -1 && isCardReason(ref)) {
+      lits = explainCard(-1, cardReasonIndex(ref), size);
+    } else if (p == -1) {
+      Clause clause = arena[ref];
+      lits = clause.literals();
+      size = clause.size();
+    } else {
+      lits = reasonLiterals(p, size);
+    }
+    if (isClauseReason(ref)) {
+      Clause clause = arena[ref];
+      if (clause.learnt()) {
+        clause.setUsed(true);
+        claBumpActivity(clause);
+        // a learnt clause taking part in a conflict keeps its best LBD //
+        unsigned int lbd = computeLbd(clause.literals(), clause.size());
+        if (lbd < clause.lbd()) {
+          clause.setLbd(lbd);
+        }
+      }
+    }
+    // lits[0] of a reason is the implied literal p itself //
+    for (int k = (p == -1 ? 0 : 1); k < size; ++k) {
+      int var = litVar(lits[k]);
+      if (!seen[var] && level[var] > 0) {
+        seen[var] = 1;
+        varBumpActivity(var);
+        if (level[var] >= decisionLevel()) {
+          pathCount++;
+        } else {
+          learnt.push_back(lits[k]);
+        }
+      }
+    }
+    // next literal of the current level to resolve on //
+    while (!seen[litVar(trail[index])]) {
+      index--;
+    }
+    p = trail[index--];
+    ref = reason[litVar(p)];
+    seen[litVar(p)] = 0;
+    pathCount--;
+  } while (pathCount > 0);
+  learnt[0] = litNeg(p);
+  TRACE(options.verbosity, VERBOSITY_TRACE, std::cout << "Unique Implication Point (UIP) found: " << litName(p) << "\n");
+
+  // recursive minimization: drop literals implied by the other literals of the clause //
+  analyzeToClear.assign(learnt.begin(), learnt.end());
+  unsigned int abstractLevels = 0;
+  for (size_t i = 1; i < learnt.size(); ++i) {
+    abstractLevels |= abstractLevel(litVar(learnt[i]));
+  }
+  size_t j = 1;
+  for (size_t i = 1; i < learnt.size(); ++i) {
+    if (reason[litVar(learnt[i])] == CREF_UNDEF || !litRedundant(learnt[i], abstractLevels)) {
+      learnt[j++] = learnt[i];
+    }
+  }
+  stats.minimizedLiterals += learnt.size() - j;
+  learnt.resize(j);
+  stats.learntLiterals += j;
+  for (int lit : analyzeToClear) {
+    seen[litVar(lit)] = 0;
+  }
+
+  // find the backjump level and watch the highest level literal //
+  int backjumpLevel = 0;
+  if (learnt.size() > 1) {
+    size_t maxIndex = 1;
+    for (size_t i = 2; i < learnt.size(); ++i) {
+      if (level[litVar(learnt[i])] > level[litVar(learnt[maxIndex])]) {
+        maxIndex = i;
+      }
+    }
+    std::swap(learnt[1], learnt[maxIndex]);
+    backjumpLevel = level[litVar(learnt[1])];
+  }
+  return backjumpLevel;
+}
+
+void CDCLSolver::analyzeFinal(int p) {
+  conflict.clear();
+  conflict.push_back(litNeg(p));
+  if (decisionLevel() == 0) {
+    return; // p holds at level 0 //
+  }
+  seen[litVar(p)] = 1;
+  for (int i = trail.size() - 1; i >= trailLim[0]; --i) {
+    int var = litVar(trail[i]);
+    if (!seen[var]) {
+      continue;
+    }
+    if (reason[var] == CREF_UNDEF) {
+      conflict.push_back(trail[i]); // below the assumption levels every decision is an assumption //
+    } else {
+      int size;
+      const int* lits = reasonLiterals(trail[i], size);
+      for (int k = 1; k < size; ++k) {
+        if (level[litVar(lits[k])] > 0) {
+          seen[litVar(lits[k])] = 1;
+        }
+      }
+    }
+    seen[var] = 0;
+  }
+}
+
+void CDCLSolver::walk() {
+  double start = wallTime();
+  if (!walker) {
+    walker.reset(new LocalSearch(options));
+  }
+  walker->reset(variables.size());
+  // the clauses as they stand at level 0: satisfied ones left out, false literals dropped //
+  std::vector<int>& lits = addBuffer;
+  for (CRef ref : clauses) {
+    Clause clause = arena[ref];
+    lits.clear();
+    bool satisfied = false;
+    for (int k = 0; k < clause.size() && !satisfied; ++k) {
+      satisfied = litValue(clause[k]) == 1;
+      if (litValue(clause[k]) == 0) {
+        lits.push_back(clause[k]);
+      }
+    }
+    if (!satisfied) {
+      walker->addClause(lits.data(), lits.size());
+    }
+  }
+  for (int p = 0; p < (int)implications.size(); ++p) {
+    int a = litNeg(p);
+    for (int q : implications[p]) {
+      if (a < q && litValue(a) == 0 && litValue(q) == 0) {
+        int binary[2] = {a, q};
+        walker->addClause(binary, 2);
+      }
+    }
+  }
+  // the first burst starts from the saved phases, the later ones go on from the best assignment //
+  // of the previous burst so the local search keeps its progress                               //
+  bool resume = walkAssignment.size() == variables.size();
+  walkAssignment.resize(variables.size());
+  for (size_t v = 0; v < variables.size(); ++v) {
+    if (assigns[v] != 0) {
+      walkAssignment[v] = assigns[v] == 1;
+    } else if (!resume) {
+      walkAssignment[v] = !polarity[v];
+    }
+  }
+  long long budget = std::max<long long>(1000, options.walkEffort * (stats.propagations - walkPropagations));
+  long long flips = walker->getFlips();
+  int unsatisfied = walker->run(walkAssignment, budget);
+  for (size_t v = 0; v < variables.size(); ++v) {
+    if (assigns[v] == 0) {
+      polarity[v] = !walkAssignment[v];
+    }
+  }
+  stats.walkBursts++;
+  stats.walkFlips += walker->getFlips() - flips;
+  stats.walkModels += unsatisfied == 0;
+  walkPropagations = stats.propagations;
+  // the bursts thin out as the search goes on, each one is as long as the search before it allows //
+  nextWalk = stats.restarts + 10 * stats.walkBursts;
+  stats.walkTime += wallTime() - start;
+  TRACE(options.verbosity, VERBOSITY_INFO, std::cout << "info: local search burst " << stats.walkBursts << ": "
+                                                     << walker->getFlips() - flips << " flips, " << unsatisfied
+                                                     << " clauses left unsatisfied\n");
+}
+
+bool CDCLSolver::restartDue() {
+  switch (options.restartPolicy) {
+    case RESTART_LUBY:
+      return conflictsSinceRestart >= luby(stats.restarts) * options.lubyUnit;
+    case RESTART_GLUCOSE:
+      return recentLbds.full() && recentLbds.average() * options.glucoseK > (double)sumLbd / stats.conflicts;
+    default:
+      return false;
+  }
+}
+
+unsigned int CDCLSolver::computeLbd(const int* lits, int size) {
+  stamp++;
+  unsigned int lbd = 0;
+  for (int k = 0; k < size; ++k) {
+    int lvl = level[litVar(lits[k])];
+    if (levelStamp[lvl] != stamp) {
+      levelStamp[lvl] = stamp;
+      lbd++;
+    }
+  }
+  return lbd;
+}
+
+bool CDCLSolver::litRedundant(int lit, unsigned int abstractLevels) {
+  analyzeStack.clear();
+  analyzeStack.push_back(lit);
+  size_t top = analyzeToClear.size();
+  while (!analyzeStack.empty()) {
+    int q = analyzeStack.back();
+    analyzeStack.pop_back();
+    int size;
+    const int* lits = reasonLiterals(litNeg(q), size);
+    for (int k = 1; k < size; ++k) {
+      int var = litVar(lits[k]);
+      if (!seen[var] && level[var] > 0) {
+        if (reason[var] != CREF_UNDEF && (abstractLevel(var) & abstractLevels) != 0) {
+          seen[var] = 1;
+          analyzeStack.push_back(lits[k]);
+          analyzeToClear.push_back(lits[k]);
+        } else {
+          for (size_t i = top; i < analyzeToClear.size(); ++i) {
+            seen[litVar(analyzeToClear[i])] = 0;
+          }
+          analyzeToClear.resize(top);
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+void CDCLSolver::cancelUntil(int backjumpLevel) {
+  if (decisionLevel() <= backjumpLevel) {
+    return;
+  }
+  for (int i = trail.size() - 1; i >= trailLim[backjumpLevel]; --i) {
+    int var = litVar(trail[i]);
+    if ((size_t)i < cardHead) {
+      for (int c : cardOccurs[trail[i]]) {
+        cards[c].count--;
+      }
+    }
+    assigns[var] = 0;
+    reason[var] = CREF_UNDEF;
+    if (options.phaseSaving) {
+      polarity[var] = litSign(trail[i]);
+    }
+    if (!orderHeap.inHeap(var)) {
+      orderHeap.insert(var);
+    }
+  }
+  trail.resize(trailLim[backjumpLevel]);
+  trailLim.resize(backjumpLevel);
+  qhead = trail.size();
+  binaryHead = trail.size();
+  cardHead = std::min(cardHead, trail.size());
+}
+
+void CDCLSolver::growVariables() {
+  size_t first = assigns.size();
+  size_t count = variables.size();
+  watches.resize(2 * count);
+  implications.resize(2 * count);
+  cardOccurs.resize(2 * count);
+  assigns.resize(count, 0);
+  level.resize(count, 0);
+  reason.resize(count, CREF_UNDEF);
+  seen.resize(count, 0);
+  activity.resize(count, 0.0);
+  levelStamp.resize(count + 1, 0);
+  polarity.resize(count, 0);
+  for (size_t v = first; v < count; ++v) {
+    if (options.initialPhase == PHASE_FALSE) {
+      polarity[v] = 1;
+    } else if (options.initialPhase == PHASE_RANDOM) {
+      polarity[v] = randomGenerator() & 1;
+    }
+    orderHeap.insert(v);
+  }
+}
+
+void CDCLSolver::attachClause(CRef ref) {
+  Clause clause = arena[ref];
+  watches[clause[0]].emplace_back(ref, clause[1]);
+  watches[clause[1]].emplace_back(ref, clause[0]);
+}
+
+void CDCLSolver::removeBinary(int a, int b) {
+  for (int k = 0; k < 2; ++k) {
+    std::vector<int>& implied = implications[litNeg(k == 0 ? a : b)];
+    auto it = std::find(implied.begin(), implied.end(), k == 0 ? b : a);
+    if (it != implied.end()) {
+      *it = implied.back();
+      implied.pop_back();
+    }
+  }
+  binaryClauses--;
+}
+
+void CDCLSolver::removeBinaryAt(int p, size_t index) {
+  std::vector<int>& implied = implications[p];
+  int target = implied[index];
+  implied[index] = implied.back();
+  implied.pop_back();
+  // with duplicates any copy of the other direction will do //
+  std::vector<int>& back = implications[litNeg(target)];
+  auto it = std::find(back.begin(), back.end(), litNeg(p));
+  if (it != back.end()) {
+    *it = back.back();
+    back.pop_back();
+  }
+  binaryClauses--;
+}
+
+void CDCLSolver::addLearntClause(const std::vector<int>& learnt) {
+  TRACE(options.verbosity, VERBOSITY_TRACE, printLearntClause(learnt));
+  if (proof != nullptr) {
+    proof->addClause(learnt);
+  }
+  unsigned int lbd = computeLbd(learnt.data(), learnt.size());
+  recentLbds.push(lbd);
+  sumLbd += lbd;
+  if (exportRing != nullptr && learnt.size() <= (size_t)ClauseRing::MAX_SIZE && lbd <= options.shareLbd) {
+    exportRing->push(learnt.data(), learnt.size(), lbd);
+    stats.exportedClauses++;
+  }
+  if (learnt.size() == 1) {
+    enqueue(learnt[0], CREF_UNDEF); // learnt units hold at level 0 and need no clause //
+    return;
+  }
+  if (learnt.size() == 2) {
+    addBinary(learnt[0], learnt[1]); // an LBD of at most 2, kept for good //
+    enqueue(learnt[0], binaryReason(learnt[1]));
+    return;
+  }
+  CRef ref = arena.alloc(learnt.data(), learnt.size(), true);
+  arena[ref].setLbd(lbd);
+  claBumpActivity(arena[ref]);
+  learnts.push_back(ref);
+  attachClause(ref);
+  enqueue(learnt[0], ref);
+}
+
+bool CDCLSolver::importClauses() {
+  unsigned int lbd;
+  for (size_t r = 0; r < importRings.size(); ++r) {
+    while (importRings[r]->read(importCursors[r], importBuffer, lbd)) {
+      stats.importedClauses++;
+      size_t j = 0;
+      bool satisfied = false;
+      for (int lit : importBuffer) {
+        if (litValue(lit) == 1) {
+          satisfied = true;
+          break;
+        }
+        if (litValue(lit) == 0) {
+          importBuffer[j++] = lit;
+        }
+      }
+      if (satisfied) {
+        continue;
+      }
+      importBuffer.resize(j);
+      if (importBuffer.empty()) {
+        ok = false;
+        return false;
+      } else if (importBuffer.size() == 1) {
+        enqueue(importBuffer[0], CREF_UNDEF);
+      } else if (importBuffer.size() == 2) {
+        addBinary(importBuffer[0], importBuffer[1]);
+      } else {
+        CRef ref = arena.alloc(importBuffer.data(), importBuffer.size(), true);
+        arena[ref].setLbd(std::min<unsigned int>(lbd, importBuffer.size()));
+        learnts.push_back(ref);
+        attachClause(ref);
+      }
+    }
+  }
+  return true;
+}
+
+CRef CDCLSolver::propagate() {
+  while (qhead < trail.size()) {
+    // binary clauses need no clause access and give the shortest reasons, so every //
+    // literal on the trail goes through them before the next long clause visit    //
+    while (binaryHead < trail.size()) {
+      int p = trail[binaryHead++];
+      for (int q : implications[p]) {
+        int value = litValue(q);
+        if (value == 0) {
+          enqueue(q, binaryReason(litNeg(p)));
+        } else if (value == -1) {
+          binaryConflictLit = litNeg(p);
+          qhead = trail.size();
+          binaryHead = trail.size();
+          return binaryReason(q);
+        }
+      }
+    }
+    int p = trail[qhead++];
+    stats.propagations++;
+    // a conflict leaves the rest of the trail uncounted, cancelUntil needs to know where that starts //
+    cardHead = qhead;
+    if (!cardOccurs[p].empty()) {
+      CRef conflictCard = propagateCards(p);
+      if (conflictCard != CREF_UNDEF) {
+        qhead = trail.size();
+        binaryHead = trail.size();
+        return conflictCard;
+      }
+    }
+    int falseLit = litNeg(p);
+    std::vector<Watcher>& ws = watches[falseLit];
+    size_t i = 0, j = 0;
+    while (i < ws.size()) {
+      // clause already satisfied by its blocker //
+      if (litValue(ws[i].blocker) == 1) {
+        ws[j++] = ws[i++];
+        continue;
+      }
+      CRef ref = ws[i].cref;
+      Clause clause = arena[ref];
+      i++;
+      if (clause.deleted()) {
+        continue; // watchers of freed clauses are dropped lazily //
+      }
+      // make sure the false literal is at position 1 //
+      if (clause[0] == falseLit) {
+        std::swap(clause[0], clause[1]);
+      }
+      int first = clause[0];
+      if (litValue(first) == 1) {
+        ws[j++] = Watcher(ref, first);
+        continue;
+      }
+      // look for a new literal to watch //
+      bool found = false;
+      for (int k = 2; k < clause.size(); ++k) {
+        if (litValue(clause[k]) != -1) {
+          clause[1] = clause[k];
+          clause[k] = falseLit;
+          watches[clause[1]].emplace_back(ref, first);
+          found = true;
+          break;
+        }
+      }
+      if (found) {
+        continue;
+      }
+      // clause is unit or conflicting under the current assignment //
+      ws[j++] = Watcher(ref, first);
+      if (litValue(first) == -1) {
+        while (i < ws.size()) {
+          ws[j++] = ws[i++];
+        }
+        ws.resize(j);
+        qhead = trail.size();
+        binaryHead = trail.size();
+        return ref;
+      }
+      enqueue(first, ref);
+    }
+    ws.resize(j);
+  }
+  return CREF_UNDEF;
+}
+
+CRef CDCLSolver::propagateCards(int p) {
+  CRef conflictCard = CREF_UNDEF;
+  for (int c : cardOccurs[p]) {
+    CardConstraint& card = cards[c];
+    card.count++;
+    if (conflictCard != CREF_UNDEF || card.count < card.bound) {
+      continue; // after a conflict the remaining counts are still brought up to date //
+    }
+    if (card.count > card.bound) {
+      conflictCard = cardReason(c);
+      continue;
+    }
+    const int* lits = cardLiterals.data() + card.start;
+    for (int k = 0; k < card.size; ++k) {
+      if (litValue(lits[k]) == 0) {
+        enqueue(litNeg(lits[k]), cardReason(c));
+      }
+    }
+  }
+  return conflictCard;
+}
+
+const int* CDCLSolver::explainCard(int p, int index, int& size) {
+  const CardConstraint& card = cards[index];
+  cardExplanation.clear();
+  if (p != -1) {
+    cardExplanation.push_back(p);
+  }
+  const int* lits = cardLiterals.data() + card.start;
+  for (int k = 0; k < card.size; ++k) {
+    if (litValue(lits[k]) == 1) {
+      cardExplanation.push_back(litNeg(lits[k]));
+    }
+  }
+  size = cardExplanation.size();
+  return cardExplanation.data();
+}
+
+bool CDCLSolver::clauseSatisfied(Clause clause) {
+  for (int k = 0; k < clause.size(); ++k) {
+    if (litValue(clause[k]) == 1) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void CDCLSolver::removeSatisfied(std::vector<CRef>& refs) {
+  size_t j = 0;
+  for (size_t i = 0; i < refs.size(); ++i) {
+    if (clauseSatisfied(arena[refs[i]])) {
+      freeClause(refs[i]);
+    } else {
+      refs[j++] = refs[i];
+    }
+  }
+  refs.resize(j);
+}
+
+void CDCLSolver::freeClause(CRef ref) {
+  if (proof != nullptr) {
+    Clause clause = arena[ref];
+    if (locked(ref)) {
+      // a satisfied reason is only removed at level 0, keep its literal as a unit so checkers do not lose it //
+      int unit = clause[0];
+      proof->addClause(&unit, 1);
+    }
+    proof->deleteClause(clause.literals(), clause.size());
+  }
+  arena.free(ref);
+}
+
+bool CDCLSolver::locked(CRef ref) {
+  Clause clause = arena[ref];
+  return reason[litVar(clause[0])] == ref && litValue(clause[0]) == 1;
+}
+
+void CDCLSolver::reduceDB() {
+  std::vector<CRef> local;
+  size_t j = 0;
+  for (size_t i = 0; i < learnts.size(); ++i) {
+    Clause clause = arena[learnts[i]];
+    bool glue = clause.lbd() <= 2;
+    bool usedTier = clause.lbd() <= options.coreLbd && clause.used();
+    if (glue || usedTier) {
+      clause.setUsed(false);
+      learnts[j++] = learnts[i];
+    } else {
+      local.push_back(learnts[i]);
+    }
+  }
+  learnts.resize(j);
+  std::sort(local.begin(), local.end(), [&](CRef a, CRef b) {
+    Clause ca = arena[a], cb = arena[b];
+    if (ca.lbd() != cb.lbd()) {
+      return ca.lbd() > cb.lbd();
+    }
+    return ca.activity() < cb.activity();
+  });
+  long long deleted = 0;
+  for (size_t i = 0; i < local.size(); ++i) {
+    if (i < local.size() / 2 && !locked(local[i])) {
+      freeClause(local[i]);
+      deleted++;
+    } else {
+      learnts.push_back(local[i]);
+    }
+  }
+  stats.reductions++;
+  stats.deletedClauses += deleted;
+  TRACE(options.verbosity, VERBOSITY_INFO, std::cout << "info: learnt clause database reduction " << stats.reductions
+                                                     << ": kept " << learnts.size() << ", deleted " << deleted << "\n");
+  checkGarbage();
+}
+
+void CDCLSolver::claBumpActivity(Clause clause) {
+  clause.setActivity(clause.activity() + claInc);
+  if (clause.activity() > 1e20) {
+    // rescale all learnt clause activities to avoid overflow //
+    for (CRef ref : learnts) {
+      Clause learnt = arena[ref];
+      learnt.setActivity(learnt.activity() * 1e-20);
+    }
+    claInc *= 1e-20;
+  }
+}
+
+void CDCLSolver::simplify() {
+  removeSatisfied(learnts);
+  removeSatisfied(clauses);
+  removeSatisfiedBinaries();
+  simplifyAssigns = trail.size();
+  if (binaryClauses >= nextBinarySimplify) {
+    simplifyBinaries();
+    nextBinarySimplify = binaryClauses + binaryClauses / 4 + 100;
+  }
+  checkGarbage();
+}
+
+void CDCLSolver::removeSatisfiedBinaries() {
+  for (size_t i = simplifyAssigns; i < trail.size(); ++i) {
+    // the clauses t + b are in implications[tbar], and t in implications[bbar] //
+    int t = trail[i];
+    std::vector<int>& implied = implications[litNeg(t)];
+    for (int b : implied) {
+      if (proof != nullptr) {
+        // keep the literal of a satisfied reason as a unit, as freeClause does //
+        if (reason[litVar(t)] == binaryReason(b)) {
+          proof->addClause(&t, 1);
+        }
+        int lits[2] = {t, b};
+        proof->deleteClause(lits, 2);
+      }
+      std::vector<int>& other = implications[litNeg(b)];
+      auto it = std::find(other.begin(), other.end(), t);
+      if (it != other.end()) {
+        *it = other.back();
+        other.pop_back();
+      }
+      binaryClauses--;
+    }
+    implied.clear();
+    implied.shrink_to_fit();
+  }
+}
+
+void CDCLSolver::simplifyBinaries() {
+  if (substituteEquivalences()) {
+    reduceTransitive();
+  }
+}
+
+bool CDCLSolver::substituteEquivalences() {
+  // Tarjan's algorithm over the unassigned literals, without recursion //
+  int literals = 2 * variables.size();
+  std::vector<int> index(literals, -1), low(literals, 0), repr(literals);
+  std::vector<char> onStack(literals, 0);
+  std::vector<int> stack;
+  std::vector<std::pair<int, size_t>> path; // literal and its next implication to follow //
+  int counter = 0;
+  for (int lit = 0; lit < literals; ++lit) {
+    repr[lit] = lit;
+  }
+  for (int root = 0; root < literals; ++root) {
+    if (index[root] != -1 || litValue(root) != 0 || implications[root].empty()) {
+      continue;
+    }
+    index[root] = low[root] = counter++;
+    stack.push_back(root);
+    onStack[root] = 1;
+    path.emplace_back(root, 0);
+    while (!path.empty()) {
+      int p = path.back().first;
+      if (path.back().second < implications[p].size()) {
+        int q = implications[p][path.back().second++];
+        if (litValue(q) != 0) {
+          continue;
+        }
+        if (index[q] == -1) {
+          index[q] = low[q] = counter++;
+          stack.push_back(q);
+          onStack[q] = 1;
+          path.emplace_back(q, 0);
+        } else if (onStack[q]) {
+          low[p] = std::min(low[p], index[q]);
+        }
+        continue;
+      }
+      path.pop_back();
+      if (!path.empty()) {
+        int parent = path.back().first;
+        low[parent] = std::min(low[parent], low[p]);
+      }
+      if (low[p] == index[p]) {
+        // a component, its smallest literal represents it. The negations form the dual //
+        // component, whose smallest literal is then the negation of this one          //
+        size_t start = stack.size();
+        int smallest = p;
+        do {
+          start--;
+          smallest = std::min(smallest, stack[start]);
+        } while (stack[start] != p);
+        for (size_t k = start; k < stack.size(); ++k) {
+          repr[stack[k]] = smallest;
+          onStack[stack[k]] = 0;
+        }
+        stack.resize(start);
+      }
+    }
+  }
+
+  int equivalent = 0;
+  for (int lit = 0; lit < literals; lit += 2) {
+    if (repr[lit] == repr[lit + 1]) {
+      // lit implies its negation and the other way round //
+      int unit = lit + 1;
+      if (proof != nullptr) {
+        proof->addClause(&unit, 1);
+      }
+      enqueue(unit, CREF_UNDEF);
+      return false;
+    }
+    if (repr[lit] != lit) {
+      equivalent++;
+    }
+  }
+  if (equivalent == 0) {
+    return true;
+  }
+  stats.equivalentVariables += equivalent;
+  TRACE(options.verbosity, VERBOSITY_INFO, std::cout << "info: " << equivalent << " equivalent variables substituted\n");
+
+  // the binaries tying each substituted literal to its representative go first, //
+  // the rewritten clauses follow from them                                      //
+  std::vector<std::pair<int, int>> binaries;
+  for (int lit = 0; lit < literals; ++lit) {
+    if (repr[lit] != lit) {
+      binaries.emplace_back(litNeg(lit), repr[lit]);
+      if (proof != nullptr) {
+        int lits[2] = {litNeg(lit), repr[lit]};
+        proof->addClause(lits, 2);
+      }
+    }
+  }
+  std::vector<int> units;
+  std::vector<int> rewritten;
+  for (int p = 0; p < literals; ++p) {
+    for (int q : implications[p]) {
+      int a = litNeg(p);
+      if (a > q) {
+        continue; // each clause once //
+      }
+      int ra = repr[a], rb = repr[q];
+      if (ra == a && rb == q) {
+        binaries.emplace_back(a, q);
+        continue;
+      }
+      if (ra == rb) {
+        units.push_back(ra);
+      } else if (ra != litNeg(rb)) {
+        binaries.emplace_back(ra, rb);
+      }
+      if (proof != nullptr) {
+        int lits[2] = {a, q};
+        if (ra == rb) {
+          proof->addClause(&ra, 1);
+        } else if (ra != litNeg(rb)) {
+          int mapped[2] = {ra, rb};
+          proof->addClause(mapped, 2);
+        }
+        proof->deleteClause(lits, 2);
+      }
+    }
+  }
+
+  // long clauses: substitute, and drop duplicates and literals false at level 0 //
+  std::vector<char> mark(literals, 0);
+  for (std::vector<CRef>* refs : {&clauses, &learnts}) {
+    size_t j = 0;
+    for (size_t i = 0; i < refs->size(); ++i) {
+      CRef ref = (*refs)[i];
+      Clause clause = arena[ref];
+      bool changed = false;
+      for (int k = 0; k < clause.size(); ++k) {
+        if (repr[clause[k]] != clause[k]) {
+          changed = true;
+          break;
+        }
+      }
+      if (!changed) {
+        (*refs)[j++] = ref;
+        continue;
+      }
+      rewritten.clear();
+      bool tautology = false;
+      for (int k = 0; k < clause.size() && !tautology; ++k) {
+        int lit = repr[clause[k]];
+        if (litValue(lit) == -1 || mark[lit]) {
+          continue;
+        }
+        tautology = mark[litNeg(lit)];
+        mark[lit] = 1;
+        rewritten.push_back(lit);
+      }
+      for (int lit : rewritten) {
+        mark[lit] = 0;
+      }
+      if (!tautology && proof != nullptr) {
+        proof->addClause(rewritten);
+      }
+      bool learnt = clause.learnt();
+      unsigned int lbd = clause.lbd();
+      float act = clause.activity();
+      freeClause(ref);
+      if (tautology) {
+        continue;
+      }
+      if (rewritten.empty()) {
+        ok = false;
+      } else if (rewritten.size() == 1) {
+        units.push_back(rewritten[0]);
+      } else if (rewritten.size() == 2) {
+        binaries.emplace_back(rewritten[0], rewritten[1]);
+      } else {
+        CRef moved = arena.alloc(rewritten.data(), rewritten.size(), learnt);
+        arena[moved].setLbd(std::min<unsigned int>(lbd, rewritten.size()));
+        arena[moved].setActivity(act);
+        (*refs)[j++] = moved;
+      }
+    }
+    refs->resize(j);
+  }
+
+  // rebuild the implication lists without duplicates, and the watches without the freed clauses //
+  for (auto& binary : binaries) {
+    if (binary.first > binary.second) {
+      std::swap(binary.first, binary.second);
+    }
+  }
+  std::sort(binaries.begin(), binaries.end());
+  binaries.erase(std::unique(binaries.begin(), binaries.end()), binaries.end());
+  for (auto& implied : implications) {
+    implied.clear();
+  }
+  binaryClauses = 0;
+  for (const auto& binary : binaries) {
+    addBinary(binary.first, binary.second);
+  }
+  for (auto& ws : watches) {
+    ws.clear();
+  }
+  for (CRef ref : clauses) {
+    attachClause(ref);
+  }
+  for (CRef ref : learnts) {
+    attachClause(ref);
+  }
+  if (!ok) {
+    return false; // the empty clause is already in the proof //
+  }
+  for (int unit : units) {
+    if (litValue(unit) == -1) {
+      // two substituted clauses became opposite units //
+      if (proof != nullptr) {
+        proof->addClause(nullptr, 0);
+      }
+      ok = false;
+      return false;
+    }
+    if (litValue(unit) == 0) {
+      enqueue(unit, CREF_UNDEF);
+    }
+  }
+  return units.empty();
+}
+
+void CDCLSolver::reduceTransitive() {
+  // each clause a + b is both abar -> b and bbar -> a, it is enough to look at one of them. //
+  // Redundant binaries are mostly found within a few steps, so each search is cut short    //
+  long long budget = binaryClauses + 10000;
+  std::vector<unsigned int> visited(2 * variables.size(), 0);
+  unsigned int mark = 0;
+  std::vector<int> pending;
+  for (int p = 0; p < (int)implications.size() && budget > 0; ++p) {
+    std::vector<int>& implied = implications[p];
+    for (size_t e = 0; e < implied.size() && budget > 0; ++e) {
+      int target = implied[e];
+      if (litNeg(p) > target) {
+        continue;
+      }
+      // search target from p without the clause itself: neither the direct implication //
+      // nor its mirror targetbar -> pbar, a path through that would prove it from itself //
+      int mirrorFrom = litNeg(target), mirrorTo = litNeg(p);
+      mark++;
+      visited[p] = mark;
+      pending.assign(1, p);
+      bool found = false;
+      bool first = true;
+      long long limit = budget - 256;
+      while (!pending.empty() && !found && budget > limit) {
+        int u = pending.back();
+        pending.pop_back();
+        const std::vector<int>& next = implications[u];
+        for (size_t k = 0; k < next.size(); ++k) {
+          budget--;
+          if (first && k == e) {
+            continue;
+          }
+          int v = next[k];
+          if (u == mirrorFrom && v == mirrorTo) {
+            continue;
+          }
+          if (v == target) {
+            found = true;
+            break;
+          }
+          if (visited[v] != mark) {
+            visited[v] = mark;
+            pending.push_back(v);
+          }
+        }
+        first = false;
+      }
+      if (found) {
+        if (proof != nullptr) {
+          int lits[2] = {litNeg(p), target};
+          proof->deleteClause(lits, 2);
+        }
+        // the last implication moves into position e, a duplicate of the clause may be elsewhere //
+        removeBinaryAt(p, e);
+        stats.transitiveBinaries++;
+        e--;
+      }
+    }
+  }
+}
+
+void CDCLSolver::checkGarbage() {
+  if (arena.wasted() > arena.size() / 5) {
+    garbageCollect();
+  }
+}
+
+void CDCLSolver::garbageCollect() {
+  ClauseArena to;
+  to.reserve(arena.size() - arena.wasted());
+  for (auto& ws : watches) {
+    size_t j = 0;
+    for (size_t i = 0; i < ws.size(); ++i) {
+      if (!arena[ws[i].cref].deleted()) {
+        ws[j] = ws[i];
+        ws[j++].cref = arena.relocate(ws[i].cref, to);
+      }
+    }
+    ws.resize(j);
+  }
+  for (int lit : trail) {
+    CRef& ref = reason[litVar(lit)];
+    if (isClauseReason(ref)) {
+      ref = arena[ref].deleted() ? CREF_UNDEF : arena.relocate(ref, to);
+    }
+  }
+  for (CRef& ref : learnts) {
+    ref = arena.relocate(ref, to);
+  }
+  for (CRef& ref : clauses) {
+    ref = arena.relocate(ref, to);
+  }
+  arena.swap(to);
+}
+
+void CDCLSolver::varBumpActivity(int var) {
+  activity[var] += varInc;
+  if (activity[var] > 1e100) {
+    // rescale all activities to avoid overflow //
+    for (double& act : activity) {
+      act *= 1e-100;
+    }
+    varInc *= 1e-100;
+  }
+  if (orderHeap.inHeap(var)) {
+    orderHeap.increase(var);
+  }
+}
+
+int CDCLSolver::pickBranchLiteral() {
+  int next = -1;
+  if (options.randomFreq > 0 && !orderHeap.empty()) {
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    if (coin(randomGenerator) < options.randomFreq) {
+      next = orderHeap.at(randomGenerator() % orderHeap.size());
+    }
+  }
+  while (next == -1 || assigns[next] != 0) {
+    if (orderHeap.empty()) {
+      return -1;
+    }
+    next = orderHeap.removeMax();
+  }
+  return mkLit(next, polarity[next]);
+}
+
+void CDCLSolver::printVariables() {
+  std::cout << "Variables<name, index>:" << std::endl;
+  int index = 0;
+  for (auto it = variables.begin(); it != variables.end(); ++it) {
+      std::cout << "<" << it->getVariable() << ", " << index << ">" << std::endl;
+      index++;
+  }
+}
+
+void CDCLSolver::printProgress() {
+  double elapsed = wallTime() - searchStart;
+  stats.print(std::cout, "c progress", elapsed);
+  std::cout << "c progress learnt_clauses=" << learnts.size() << " level0_assignments="
+            << (trailLim.empty() ? trail.size() : trailLim[0]) << std::endl;
+}
+
+void CDCLSolver::printLearntClause(const std::vector<int>& learnt) {
+  std::cout << "info: ";
+  for (size_t i = 0; i < learnt.size(); ++i) {
+    std::cout << (i > 0 ? "+" : "") << litName(learnt[i]);
+  }
+  std::cout << " conflict clause is added to the clauses \n";
+}
+
+void CDCLSolver::printDecisionTrail() {
+    std::cout << "Decision Trail<literal, graph level>:" ;
+    for (int lit : trail) {
+        std::cout << "<" << litName(lit) << "," << level[litVar(lit)] << ">" <<" ";
+    }
+    std::cout << "\n";
+}
+
+//                                        *************** Preprocessor ******************** //
+
+bool Preprocessor::run(const ClauseVector& input, int numVars, ClauseVector& output) {
+  double start = wallTime();
+  occurs.resize(2 * numVars);
+  for (std::vector<int>& list : occurs) {
+    list.clear(); // a reused preprocessor keeps the list capacity //
+  }
+  numOccurs.assign(2 * numVars, 0);
+  values.assign(numVars, 0);
+  eliminated.assign(numVars, 0);
+  frozen.assign(numVars, 0);
+  for (int i = 0; i < input.getNumCardinalities(); ++i) {
+    for (int k = 0; k < input.getCardinalitySize(i); ++k) {
+      frozen[litVar(input.getCardinality(i)[k])] = 1;
+    }
+  }
+  probeValues.assign(numVars, 0);
+  stats.originalClauses = input.getSize();
+  std::vector<int> clause;
+  for (int i = 0; i < input.getSize() && ok; ++i) {
+    const int* lits = input.getClause(i);
+    clause.assign(lits, lits + input.getClauseSize(i));
+    addClause(clause);
+  }
+  ok = ok && propagateUnits() && subsumeAll() && probe() && eliminate() && subsumeAll();
+
+  if (!ok) {
+    if (proof != nullptr) {
+      proof->addClause(nullptr, 0);
+    }
+    output.addClause(nullptr, 0);
+    stats.remainingClauses = 1;
+  } else {
+    // the top level units are passed on so that the solver assigns them too //
+    for (int v = 0; v < numVars; ++v) {
+      if (values[v] != 0) {
+        int lit = mkLit(v, values[v] == -1);
+        output.addClause(&lit, 1);
+        stats.remainingClauses++;
+      }
+    }
+    for (const Entry& entry : clauses) {
+      if (!entry.deleted) {
+        output.addClause(entry.lits.data(), entry.lits.size());
+        stats.remainingClauses++;
+      }
+    }
+    for (int i = 0; i < input.getNumCardinalities(); ++i) {
+      output.addAtMost(input.getCardinality(i), input.getCardinalitySize(i), input.getCardinalityBound(i));
+    }
+  }
+  stats.time = wallTime() - start;
+  return ok;
+}
+
+void Preprocessor::extendModel(std::vector<Variable>& vars) {
+  // later eliminations first, their clauses may contain variables eliminated before //
+  for (size_t i = elimClauses.size(); i-- > 0;) {
+    const std::vector<int>& clause = elimClauses[i];
+    bool satisfied = false;
+    for (int lit : clause) {
+      if (vars[litVar(lit)].getAssignment() != litSign(lit)) {
+        satisfied = true;
+        break;
+      }
+    }
+    if (!satisfied) {
+      vars[litVar(clause[0])].setAssignment(!litSign(clause[0]));
+    }
+  }
+}
+
+void Preprocessor::addClause(const std::vector<int>& input) {
+  if (!ok) {
+    return;
+  }
+  std::vector<int>& lits = addBuffer;
+  lits.assign(input.begin(), input.end());
+  std::sort(lits.begin(), lits.end());
+  size_t j = 0;
+  for (size_t i = 0; i < lits.size(); ++i) {
+    if (litValue(lits[i]) == 1 || (j > 0 && lits[i] == litNeg(lits[j - 1]))) {
+      return;
+    }
+    if (litValue(lits[i]) == 0 && (j == 0 || lits[i] != lits[j - 1])) {
+      lits[j++] = lits[i];
+    }
+  }
+  lits.resize(j);
+  if (proof != nullptr && lits.size() < input.size()) {
+    proof->addClause(lits);
+  }
+  if (lits.empty()) {
+    ok = false;
+    return;
+  }
+  if (lits.size() == 1) {
+    assignUnit(lits[0]);
+    return;
+  }
+  int c = clauses.size();
+  clauses.push_back(Entry{lits, signature(lits), false});
+  for (int lit : lits) {
+    occurs[lit].push_back(c);
+    numOccurs[lit]++;
+  }
+  subsumeQueue.push_back(c);
+  queued.push_back(1);
+}
+
+void Preprocessor::removeClause(int c) {
+  if (proof != nullptr && clauses[c].lits.size() > 1) {
+    proof->deleteClause(clauses[c].lits);
+  }
+  clauses[c].deleted = true;
+  for (int lit : clauses[c].lits) {
+    numOccurs[lit]--;
+  }
+}
+
+void Preprocessor::strengthen(int c, int lit) {
+  Entry& entry = clauses[c];
+  entry.lits.erase(std::find(entry.lits.begin(), entry.lits.end(), lit));
+  if (proof != nullptr) {
+    // the shorter clause follows by unit propagation, the longer one goes //
+    proof->addClause(entry.lits);
+    entry.lits.push_back(lit);
+    proof->deleteClause(entry.lits);
+    entry.lits.pop_back();
+  }
+  numOccurs[lit]--;
+  std::vector<int>& os = occurs[lit];
+  os.erase(std::find(os.begin(), os.end(), c));
+  if (entry.lits.size() == 1) {
+    assignUnit(entry.lits[0]);
+    removeClause(c);
+    return;
+  }
+  entry.signature = signature(entry.lits);
+  if (!queued[c]) {
+    queued[c] = 1;
+    subsumeQueue.push_back(c);
+  }
+}
+
+void Preprocessor::assignUnit(int lit) {
+  if (litValue(lit) == 1) {
+    return;
+  }
+  if (litValue(lit) == -1) {
+    ok = false;
+    return;
+  }
+  values[litVar(lit)] = litSign(lit) ? -1 : 1;
+  units.push_back(lit);
+}
+
+bool Preprocessor::propagateUnits() {
+  while (ok && unitsHead < units.size()) {
+    int lit = units[unitsHead++];
+    for (int c : cleanOccurs(lit)) {
+      removeClause(c);
+    }
+    occurs[lit].clear();
+    std::vector<int> falsified = cleanOccurs(litNeg(lit));
+    for (int c : falsified) {
+      if (!clauses[c].deleted) {
+        strengthen(c, litNeg(lit));
+      }
+    }
+  }
+  return ok;
+}
+
+std::vector<int>& Preprocessor::cleanOccurs(int lit) {
+  std::vector<int>& os = occurs[lit];
+  size_t j = 0;
+  for (size_t i = 0; i < os.size(); ++i) {
+    if (!clauses[os[i]].deleted) {
+      os[j++] = os[i];
+    }
+  }
+  os.resize(j);
+  return os;
+}
+
+int Preprocessor::subsumes(const Entry& a, const Entry& b) {
+  int flipped = -1;
+  for (int lit : a.lits) {
+    if (std::binary_search(b.lits.begin(), b.lits.end(), lit)) {
+      continue;
+    }
+    if (flipped == -1 && std::binary_search(b.lits.begin(), b.lits.end(), litNeg(lit))) {
+      flipped = litNeg(lit);
+      continue;
+    }
+    return -2;
+  }
+  return flipped;
+}
+
+void Preprocessor::backwardSubsume(int c) {
+  // every clause c subsumes contains the literal of c with the fewest occurrences, //
+  // or its negation when c only strengthens it                                     //
+  int best = clauses[c].lits[0];
+  for (int lit : clauses[c].lits) {
+    if (numOccurs[lit] + numOccurs[litNeg(lit)] < numOccurs[best] + numOccurs[litNeg(best)]) {
+      best = lit;
+    }
+  }
+  for (int lit : {best, litNeg(best)}) {
+    std::vector<int> candidates = cleanOccurs(lit);
+    for (int d : candidates) {
+      const Entry& a = clauses[c];
+      const Entry& b = clauses[d];
+      if (d == c || b.deleted || a.lits.size() > b.lits.size() || (a.signature & ~b.signature) != 0) {
+        continue;
+      }
+      subsumeSteps += a.lits.size();
+      int result = subsumes(a, b);
+      if (result == -1) {
+        removeClause(d);
+        stats.subsumedClauses++;
+      } else if (result >= 0) {
+        strengthen(d, result);
+        stats.strengthenedClauses++;
+      }
+    }
+  }
+}
+
+bool Preprocessor::subsumeAll() {
+  while (propagateUnits() && !subsumeQueue.empty()) {
+    if (subsumeSteps >= SUBSUME_BUDGET) {
+      for (int c : subsumeQueue) {
+        queued[c] = 0;
+      }
+      subsumeQueue.clear();
+      break;
+    }
+    int c = subsumeQueue.back();
+    subsumeQueue.pop_back();
+    queued[c] = 0;
+    if (!clauses[c].deleted) {
+      backwardSubsume(c);
+    }
+  }
+  return ok;
+}
+
+bool Preprocessor::probeLiteral(int lit) {
+  probeTrail.clear();
+  probeTrail.push_back(lit);
+  probeValues[litVar(lit)] = litSign(lit) ? -1 : 1;
+  // units are propagated before every probe, so live clauses have no assigned literal //
+  for (size_t head = 0; head < probeTrail.size(); ++head) {
+    int falseLit = litNeg(probeTrail[head]);
+    for (int c : occurs[falseLit]) {
+      if (clauses[c].deleted) {
+        continue;
+      }
+      probeSteps++;
+      int unassigned = -1;
+      int count = 0;
+      bool satisfied = false;
+      for (int q : clauses[c].lits) {
+        int value = litSign(q) ? -probeValues[litVar(q)] : probeValues[litVar(q)];
+        if (value == 1) {
+          satisfied = true;
+          break;
+        }
+        if (value == 0) {
+          unassigned = q;
+          if (++count > 1) {
+            break;
+          }
+        }
+      }
+      if (satisfied || count > 1) {
+        continue;
+      }
+      if (count == 0) {
+        return false;
+      }
+      probeValues[litVar(unassigned)] = litSign(unassigned) ? -1 : 1;
+      probeTrail.push_back(unassigned);
+    }
+  }
+  return true;
+}
+
+bool Preprocessor::probe() {
+  std::vector<int> implied;
+  std::vector<int> necessary;
+  for (size_t v = 0; v < values.size() && probeSteps < PROBE_BUDGET; ++v) {
+    if (!propagateUnits()) {
+      return false;
+    }
+    int pos = mkLit(v, false);
+    if (values[v] != 0 || numOccurs[pos] == 0 || numOccurs[litNeg(pos)] == 0) {
+      continue;
+    }
+    bool posOk = probeLiteral(pos);
+    implied.assign(probeTrail.begin() + 1, probeTrail.end());
+    for (int lit : probeTrail) {
+      probeValues[litVar(lit)] = 0;
+    }
+    if (!posOk) {
+      stats.failedLiterals++;
+      int unit = litNeg(pos);
+      if (proof != nullptr) {
+        proof->addClause(&unit, 1);
+      }
+      assignUnit(unit);
+      continue;
+    }
+    bool negOk = probeLiteral(litNeg(pos));
+    // literals implied by both polarities hold anyway //
+    necessary.clear();
+    for (int lit : implied) {
+      if (negOk && (litSign(lit) ? -probeValues[litVar(lit)] : probeValues[litVar(lit)]) == 1) {
+        necessary.push_back(lit);
+      }
+    }
+    for (int lit : probeTrail) {
+      probeValues[litVar(lit)] = 0;
+    }
+    if (!negOk) {
+      stats.failedLiterals++;
+      if (proof != nullptr) {
+        proof->addClause(&pos, 1);
+      }
+      assignUnit(pos);
+      continue;
+    }
+    for (int lit : necessary) {
+      if (proof != nullptr) {
+        // lit follows from both polarities by unit propagation, so do the two binaries and lit //
+        int withPos[2] = {litNeg(pos), lit};
+        int withNeg[2] = {pos, lit};
+        proof->addClause(withPos, 2);
+        proof->addClause(withNeg, 2);
+        proof->addClause(&lit, 1);
+        proof->deleteClause(withPos, 2);
+        proof->deleteClause(withNeg, 2);
+      }
+      assignUnit(lit);
+      stats.probedUnits++;
+    }
+  }
+  return propagateUnits();
+}
+
+bool Preprocessor::resolve(const std::vector<int>& a, const std::vector<int>& b, int var, std::vector<int>& resolvent) {
+  // both clauses are sorted, so are their merge and a literal next to its negation //
+  resolvent.clear();
+  size_t i = 0, j = 0;
+  while (i < a.size() || j < b.size()) {
+    int lit = (j == b.size() || (i < a.size() && a[i] <= b[j])) ? a[i++] : b[j++];
+    if (litVar(lit) == var || (!resolvent.empty() && resolvent.back() == lit)) {
+      continue;
+    }
+    if (!resolvent.empty() && resolvent.back() == litNeg(lit)) {
+      return false;
+    }
+    resolvent.push_back(lit);
+  }
+  return true;
+}
+
+bool Preprocessor::tryEliminate(int var) {
+  int pos = mkLit(var, false);
+  int neg = mkLit(var, true);
+  size_t total = numOccurs[pos] + numOccurs[neg];
+  if (total == 0 || total > (size_t)options.elimOccurrences) {
+    return false;
+  }
+  std::vector<int> posClauses = cleanOccurs(pos);
+  std::vector<int> negClauses = cleanOccurs(neg);
+  // clause count bound: eliminate only when there are no more resolvents than clauses //
+  std::vector<std::vector<int>> resolvents;
+  std::vector<int> resolvent;
+  for (int p : posClauses) {
+    for (int n : negClauses) {
+      if (resolve(clauses[p].lits, clauses[n].lits, var, resolvent)) {
+        if (resolvents.size() == total || resolvent.size() > (size_t)RESOLVENT_LIMIT) {
+          return false;
+        }
+        resolvents.push_back(resolvent);
+      }
+    }
+  }
+  // the resolvents go into the proof while their parents are still there //
+  if (proof != nullptr) {
+    for (const std::vector<int>& r : resolvents) {
+      proof->addClause(r);
+    }
+  }
+  for (const std::vector<int>* side : {&posClauses, &negClauses}) {
+    for (int c : *side) {
+      std::vector<int> saved = clauses[c].lits;
+      std::iter_swap(saved.begin(), std::find_if(saved.begin(), saved.end(), [&](int lit) { return litVar(lit) == var; }));
+      elimClauses.push_back(saved);
+      removeClause(c);
+    }
+  }
+  occurs[pos].clear();
+  occurs[neg].clear();
+  eliminated[var] = 1;
+  stats.eliminatedVariables++;
+  for (const std::vector<int>& r : resolvents) {
+    addClause(r);
+    stats.resolvents++;
+  }
+  return ok;
+}
+
+bool Preprocessor::eliminate() {
+  // cheapest variables first //
+  std::vector<int> order;
+  for (size_t v = 0; v < values.size(); ++v) {
+    if (values[v] == 0) {
+      order.push_back(v);
+    }
+  }
+  std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+    return numOccurs[mkLit(a, false)] + numOccurs[mkLit(a, true)] < numOccurs[mkLit(b, false)] + numOccurs[mkLit(b, true)];
+  });
+  for (int var : order) {
+    if (values[var] != 0 || eliminated[var] || frozen[var]) {
+      continue;
+    }
+    if (tryEliminate(var) && !subsumeAll()) {
+      return false;
+    }
+    if (!ok) {
+      return false;
+    }
+  }
+  return ok;
+}
+
+//                                        *************** Portfolio ******************** //
+
+SolverOptions Portfolio::workerOptions(int i) {
+  SolverOptions opts = options;
+  opts.seed = options.seed + 7919 * i;
+  opts.restartPolicy = (i % 2 == 0) ? options.restartPolicy : RESTART_LUBY;
+  opts.initialPhase = (InitialPhase)((options.initialPhase + i / 2) % 4);
+  opts.randomFreq = (i % 4 == 3) ? std::max(options.randomFreq, 0.01) : options.randomFreq;
+  opts.phaseSaving = (i % 8 == 5) ? false : options.phaseSaving;
+  // only the first worker reports progress, and nobody traces //
+  opts.verbosity = (i == 0) ? std::min(options.verbosity, (int)VERBOSITY_PROGRESS) : VERBOSITY_QUIET;
+  return opts;
+}
+
+void Portfolio::work(int i) {
+  solvers[i].reset(new CDCLSolver(clauseVector, variables, workerOptions(i)));
+  std::vector<ClauseRing*> others;
+  for (size_t r = 0; r < rings.size(); ++r) {
+    if ((int)r != i) {
+      others.push_back(rings[r].get());
+    }
+  }
+  solvers[i]->setSharing(rings[i].get(), others, &stop);
+  int answer = solvers[i]->solveLimited();
+  int expected = -1;
+  if (answer != 0 && winner.compare_exchange_strong(expected, i)) {
+    result = answer;
+    stop.store(true);
+  }
+}
+
+int Portfolio::solve() {
+  int numThreads = options.threads;
+  for (int i = 0; i < numThreads; ++i) {
+    rings.emplace_back(new ClauseRing());
+  }
+  solvers.resize(numThreads);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < numThreads; ++i) {
+    threads.emplace_back(&Portfolio::work, this, i);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return result;
+}
+
+//                                        *************** CubeAndConquer ******************** //
+
+CubeAndConquer::CubeAndConquer(const ClauseVector& clauseVec, std::vector<Variable>& vars, const SolverOptions& opts)
+    : clauseVector(clauseVec), variables(vars), options(opts), openCubes(0), stop(false), winner(-1), result(0),
+      lookaheads(0) {
+  std::vector<int> occurrences(variables.size(), 0);
+  for (int i = 0; i < clauseVector.getSize(); ++i) {
+    const int* lits = clauseVector.getClause(i);
+    for (int k = 0; k < clauseVector.getClauseSize(i); ++k) {
+      occurrences[litVar(lits[k])]++;
+    }
+  }
+  for (size_t v = 0; v < variables.size(); ++v) {
+    if (occurrences[v] > 0) {
+      candidates.push_back(v);
+    }
+  }
+  std::stable_sort(candidates.begin(), candidates.end(), [&](int a, int b) { return occurrences[a] > occurrences[b]; });
+}
+
+int CubeAndConquer::split(CDCLSolver& solver, std::vector<int>& cube, int& branchVar) {
+  while (true) {
+    if (!solver.assumeCube(cube)) {
+      return -1;
+    }
+    long long bestScore = -1;
+    int forced = -1;
+    int scored = 0;
+    branchVar = -1;
+    for (int var : candidates) {
+      if (scored == LOOKAHEAD_CANDIDATES) {
+        break;
+      }
+      if (solver.varValue(var) != 0) {
+        continue;
+      }
+      scored++;
+      int pos = solver.lookahead(mkLit(var, false));
+      int neg = solver.lookahead(mkLit(var, true));
+      lookaheads += 2;
+      if (pos < 0 && neg < 0) {
+        return -1;
+      }
+      if (pos < 0 || neg < 0) {
+        forced = mkLit(var, pos < 0); // failed literal: the other polarity holds under the cube //
+        break;
+      }
+      long long score = (long long)pos * neg;
+      if (score > bestScore) {
+        bestScore = score;
+        branchVar = var;
+      }
+    }
+    if (forced == -1) {
+      return branchVar == -1 ? 0 : 1;
+    }
+    cube.push_back(forced);
+  }
+}
+
+void CubeAndConquer::finish(int id, int answer) {
+  std::lock_guard<std::mutex> guard(lock);
+  int expected = -1;
+  if (winner.compare_exchange_strong(expected, id)) {
+    result = answer;
+  }
+  stop.store(true);
+  workAvailable.notify_all();
+}
+
+void CubeAndConquer::work(int id) {
+  SolverOptions opts = options;
+  opts.seed = options.seed + 7919 * id;
+  opts.verbosity = (id == 0) ? std::min(options.verbosity, (int)VERBOSITY_PROGRESS) : VERBOSITY_QUIET;
+  if (!solvers[id]) {
+    solvers[id].reset(new CDCLSolver(clauseVector, variables, opts));
+  }
+  CDCLSolver& solver = *solvers[id];
+  std::vector<ClauseRing*> others;
+  for (size_t r = 0; r < rings.size(); ++r) {
+    if ((int)r != id) {
+      others.push_back(rings[r].get());
+    }
+  }
+  solver.setSharing(rings[id].get(), others, &stop);
+  Cube cube;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> guard(lock);
+      workAvailable.wait(guard, [&]() { return !queue.empty() || openCubes == 0 || stop; });
+      if (stop || queue.empty()) {
+        return;
+      }
+      cube = std::move(queue.front());
+      queue.pop_front();
+    }
+    solver.setConflictBudget(cube.budget);
+    int answer = solver.solveLimited(cube.lits);
+    if (answer == 1 || (answer == -1 && !solver.okay())) {
+      finish(id, answer);
+      return;
+    }
+    if (stop) {
+      return;
+    }
+    // out of conflicts: the cube is much harder than expected, split it again //
+    int branchVar = -1;
+    int splitResult = (answer == -1) ? -1 : split(solver, cube.lits, branchVar);
+    bool closed = false;
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      if (answer == -1) {
+        stats.solvedCubes++;
+      } else if (splitResult == -1) {
+        stats.refutedCubes++;
+      }
+      if (splitResult == -1) {
+        closed = --openCubes == 0;
+      } else if (splitResult == 0) {
+        queue.push_back(Cube{cube.lits, -1}); // nothing left to split on, solve it to the end //
+      } else {
+        stats.resplits++;
+        openCubes++;
+        long long budget = 2 * cube.budget;
+        cube.lits.push_back(mkLit(branchVar, false));
+        queue.push_back(Cube{cube.lits, budget});
+        cube.lits.back() = mkLit(branchVar, true);
+        queue.push_back(Cube{cube.lits, budget});
+      }
+      workAvailable.notify_all();
+    }
+    if (closed) {
+      finish(id, -1); // every cube is unsatisfiable //
+      return;
+    }
+  }
+}
+
+int CubeAndConquer::solve() {
+  int numThreads = options.threads;
+  for (int i = 0; i < numThreads; ++i) {
+    rings.emplace_back(new ClauseRing());
+  }
+  solvers.resize(numThreads);
+  SolverOptions opts = options;
+  opts.verbosity = std::min(options.verbosity, (int)VERBOSITY_PROGRESS);
+  solvers[0].reset(new CDCLSolver(clauseVector, variables, opts));
+
+  // lookahead phase: split breadth first until there are enough cubes //
+  double start = wallTime();
+  size_t target = options.cubes > 0 ? options.cubes : 8 * numThreads;
+  std::deque<std::vector<int>> frontier(1);
+  std::vector<std::vector<int>> leaves; // cubes without a variable left to split on //
+  while (!frontier.empty() && frontier.size() + leaves.size() < target) {
+    std::vector<int> cube = std::move(frontier.front());
+    frontier.pop_front();
+    int branchVar;
+    int splitResult = split(*solvers[0], cube, branchVar);
+    if (splitResult == -1) {
+      stats.refutedCubes++;
+    } else if (splitResult == 0) {
+      leaves.push_back(cube);
+    } else {
+      cube.push_back(mkLit(branchVar, false));
+      frontier.push_back(cube);
+      cube.back() = mkLit(branchVar, true);
+      frontier.push_back(cube);
+    }
+  }
+  for (auto& cube : frontier) {
+    queue.push_back(Cube{cube, options.cubeConflicts});
+  }
+  for (auto& cube : leaves) {
+    queue.push_back(Cube{cube, -1});
+  }
+  stats.initialCubes = queue.size();
+  stats.lookaheadTime = wallTime() - start;
+  TRACE(options.verbosity, VERBOSITY_INFO, std::cout << "info: lookahead made " << queue.size() << " cubes, "
+                                                     << stats.refutedCubes << " refuted\n");
+
+  start = wallTime();
+  openCubes = queue.size();
+  if (openCubes == 0) {
+    winner = 0;
+    result = -1;
+  } else {
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numThreads; ++i) {
+      threads.emplace_back(&CubeAndConquer::work, this, i);
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+  stats.conquerTime = wallTime() - start;
+  stats.lookaheads = lookaheads;
+  return result;
+}
+
+//                                        *************** Batch mode ******************** //
+
+FormulaStream::~FormulaStream() {
+  if (fd >= 0) {
+    close(fd);
+  }
+}
+
+bool FormulaStream::open(const std::string& filename) {
+  fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    std::cerr << "Unable to open file: " << filename << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool FormulaStream::readLine(std::string& line) {
+  line.clear();
+  while (true) {
+    if (position == filled) {
+      ssize_t n = read(fd, buffer.data(), buffer.size());
+      if (n <= 0) {
+        return !line.empty();
+      }
+      position = 0;
+      filled = n;
+    }
+    const char* start = buffer.data() + position;
+    const char* newline = static_cast<const char*>(std::memchr(start, '\n', filled - position));
+    if (newline == nullptr) {
+      line.append(start, filled - position);
+      position = filled;
+      continue;
+    }
+    line.append(start, newline - start);
+    position += newline - start + 1;
+    return true;
+  }
+}
+
+bool FormulaStream::next(std::string& formula) {
+  formula.clear();
+  bool content = false;
+  bool header = false;
+  if (!pendingHeader.empty()) {
+    formula = pendingHeader;
+    pendingHeader.clear();
+    content = header = true;
+  }
+  std::string line;
+  while (readLine(line)) {
+    size_t first = line.find_first_not_of(" \t\r");
+    bool blank = first == std::string::npos;
+    if (format == 0 && !blank) {
+      char c = line[first];
+      bool word = first + 1 == line.size() || line[first + 1] == ' ' || line[first + 1] == '\t' || line[first + 1] == '\r';
+      format = ((c == 'p' || c == 'c') && word) ? 1 : 2;
+    }
+    if (format == 1) {
+      if (!blank && line[first] == '%') {
+        // skip the trailer up to the next header //
+        while (readLine(line) && line.compare(0, 1, "p") != 0) {
+        }
+        if (line.compare(0, 1, "p") == 0) {
+          pendingHeader = line + "\n";
+        }
+        return content;
+      }
+      if (!blank && line[first] == 'p') {
+        if (header) {
+          pendingHeader = line + "\n";
+          return true;
+        }
+        header = true;
+      }
+    } else if (blank) {
+      if (content) {
+        return true;
+      }
+      continue;
+    }
+    formula += line;
+    formula += '\n';
+    content = content || !blank;
+  }
+  return content;
+}
+
+BatchSolver::BatchSolver(const SolverOptions& opts)
+    : options(opts), numThreads(opts.threads), queuedTasks(0), inputDone(false), satisfiable(0), unsatisfiable(0),
+      errors(0), steals(0) {
+  // solver output would interleave between the workers //
+  options.verbosity = VERBOSITY_QUIET;
+  for (int i = 0; i < numThreads; ++i) {
+    queues.emplace_back(new WorkerQueue());
+  }
+}
+
+bool BatchSolver::takeTask(int id, Task& task) {
+  while (true) {
+    // oldest tasks first from every queue, which keeps the output flowing in order //
+    for (int k = 0; k < numThreads; ++k) {
+      WorkerQueue& queue = *queues[(id + k) % numThreads];
+      std::lock_guard<std::mutex> guard(queue.lock);
+      if (!queue.tasks.empty()) {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        queuedTasks--;
+        if (k > 0) {
+          steals++;
+        }
+        return true;
+      }
+    }
+    std::unique_lock<std::mutex> lock(taskLock);
+    taskAvailable.wait(lock, [&]() { return queuedTasks > 0 || inputDone; });
+    if (queuedTasks == 0 && inputDone) {
+      return false;
+    }
+  }
+}
+
+void BatchSolver::solveTask(const Task& task, ClauseVector& formula, Preprocessor& preprocessor, ClauseVector& simplified,
+                            CDCLSolver& solver, std::string& line) {
+  line = std::to_string(task.index + 1) + ": ";
+  formula.clear();
+  if (!formula.parse(task.text.data(), task.text.size())) {
+    errors++;
+    line += "parse error\n";
+    return;
+  }
+  preprocessor.clear();
+  simplified.clear();
+  if (options.preprocess) {
+    preprocessor.run(formula, formula.getVariables().size(), simplified);
+  }
+  solver.load(options.preprocess ? simplified : formula, formula.getVariables());
+  if (!solver.solve()) {
+    unsatisfiable++;
+    line += "unsatisfiable\n";
+    return;
+  }
+  satisfiable++;
+  std::vector<Variable>& vars = solver.getVariables();
+  preprocessor.extendModel(vars);
+  line += "satisfiable";
+  for (Variable& var : vars) {
+    line += ' ';
+    line += var.getVariable();
+    if (!var.getAssignment()) {
+      line += "bar";
+    }
+  }
+  line += '\n';
+}
+
+void BatchSolver::work(int id) {
+  ClauseVector formula;
+  Preprocessor preprocessor(options);
+  ClauseVector simplified;
+  CDCLSolver solver(options);
+  std::string line;
+  Task task;
+  while (takeTask(id, task)) {
+    solveTask(task, formula, preprocessor, simplified, solver, line);
+    std::lock_guard<std::mutex> guard(resultLock);
+    results[task.index] = line;
+    resultReady.notify_one();
+  }
+}
+
+void BatchSolver::printReady(long long& nextIndex, bool wait, std::ostream& out) {
+  std::unique_lock<std::mutex> lock(resultLock);
+  if (wait) {
+    resultReady.wait(lock, [&]() { return results.count(nextIndex) > 0; });
+  }
+  for (auto it = results.begin(); it != results.end() && it->first == nextIndex; it = results.erase(it)) {
+    out << it->second;
+    nextIndex++;
+  }
+}
+
+void BatchSolver::run(FormulaStream& input, std::ostream& out) {
+  double start = wallTime();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < numThreads; ++i) {
+    threads.emplace_back(&BatchSolver::work, this, i);
+  }
+  // at most this many formulas are read ahead of the first unprinted one //
+  const long long maxInFlight = 64LL * numThreads;
+  long long count = 0;
+  long long nextIndex = 0;
+  std::string text;
+  while (input.next(text)) {
+    WorkerQueue& queue = *queues[count % numThreads];
+    {
+      std::lock_guard<std::mutex> guard(queue.lock);
+      queue.tasks.push_back(Task{count, text});
+    }
+    {
+      std::lock_guard<std::mutex> guard(taskLock);
+      queuedTasks++;
+    }
+    taskAvailable.notify_one();
+    count++;
+    printReady(nextIndex, false, out);
+    while (count - nextIndex > maxInFlight) {
+      printReady(nextIndex, true, out);
+    }
+  }
+  {
+    std::lock_guard<std::mutex> guard(taskLock);
+    inputDone = true;
+  }
+  taskAvailable.notify_all();
+  while (nextIndex < count) {
+    printReady(nextIndex, true, out);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  out.flush();
+  stats.formulas = count;
+  stats.satisfiable = satisfiable;
+  stats.unsatisfiable = unsatisfiable;
+  stats.errors = errors;
+  stats.steals = steals;
+  stats.time = wallTime() - start;
+}
+
+//                                        *************** Server mode ******************** //
+
+void ServerStatistics::print(std::ostream& out) const {
+  std::vector<double> sorted(latencies);
+  std::sort(sorted.begin(), sorted.end());
+  double p50 = sorted.empty() ? 0 : sorted[sorted.size() / 2];
+  double p99 = sorted.empty() ? 0 : sorted[std::min(sorted.size() - 1, sorted.size() * 99 / 100)];
+  double worst = sorted.empty() ? 0 : sorted.back();
+  out << "c server requests=" << requests << " satisfiable=" << satisfiable << " unsatisfiable=" << unsatisfiable
+      << " errors=" << errors << " p50_ms=" << p50 * 1000 << " p99_ms=" << p99 * 1000 << " max_ms=" << worst * 1000
+      << "\n";
+}
+
+SolverServer::SolverServer(const SolverOptions& opts) : options(opts), listenFd(-1), stopping(false) {
+  // stdout carries the responses //
+  options.verbosity = VERBOSITY_QUIET;
+}
+
+bool SolverServer::readLine(Connection& conn, std::string& line) {
+  line.clear();
+  while (true) {
+    if (conn.position == conn.filled) {
+      ssize_t n = read(conn.fd, conn.buffer.data(), conn.buffer.size());
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      if (n <= 0) {
+        return false;
+      }
+      conn.position = 0;
+      conn.filled = n;
+    }
+    const char* start = conn.buffer.data() + conn.position;
+    const char* newline = static_cast<const char*>(std::memchr(start, '\n', conn.filled - conn.position));
+    size_t length = (newline == nullptr ? conn.buffer.data() + conn.filled : newline) - start;
+    line.append(start, length);
+    conn.position += length;
+    if (newline != nullptr) {
+      conn.position++;
+      return true;
+    }
+    if (line.size() > 64) {
+      return false; // not a header //
+    }
+  }
+}
+
+bool SolverServer::readPayload(Connection& conn, std::string& payload, size_t size) {
+  payload.clear();
+  while (payload.size() < size) {
+    if (conn.position == conn.filled) {
+      ssize_t n = read(conn.fd, conn.buffer.data(), conn.buffer.size());
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      if (n <= 0) {
+        return false;
+      }
+      conn.position = 0;
+      conn.filled = n;
+    }
+    size_t length = std::min(size - payload.size(), conn.filled - conn.position);
+    payload.append(conn.buffer.data() + conn.position, length);
+    conn.position += length;
+  }
+  return true;
+}
+
+bool SolverServer::writeFrame(Connection& conn, char kind, const std::string& payload) {
+  std::string frame;
+  frame.reserve(payload.size() + 24);
+  frame += kind;
+  frame += ' ';
+  frame += std::to_string(payload.size());
+  frame += '\n';
+  frame += payload;
+  size_t written = 0;
+  while (written < frame.size()) {
+    ssize_t n = write(conn.outFd, frame.data() + written, frame.size() - written);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    written += n;
+  }
+  return true;
+}
+
+bool SolverServer::parseLiterals(const std::string& payload, std::vector<int>& lits, bool clauses) {
+  lits.clear();
+  const char* p = payload.c_str();
+  while (true) {
+    while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') {
+      p++;
+    }
+    if (*p == '\0') {
+      break;
+    }
+    char* end;
+    long value = std::strtol(p, &end, 10);
+    if (end == p || value > (1 << 29) || value < -(1 << 29)) {
+      return false;
+    }
+    p = end;
+    if (value == 0) {
+      if (clauses) {
+        lits.push_back(-1); // end of clause //
+      }
+      continue;
+    }
+    lits.push_back(mkLit(std::abs(value) - 1, value < 0));
+  }
+  return !clauses || lits.empty() || lits.back() == -1;
+}
+
+char SolverServer::answer(char kind, const std::string& payload, Session& session) {
+  std::string& response = session.response;
+  response.clear();
+  if (kind == 'f') {
+    session.formula.clear();
+    if (!session.formula.parse(payload.data(), payload.size())) {
+      response = "parse error\n";
+      return 'e';
+    }
+    Preprocessor& preprocessor = session.preprocessor;
+    ClauseVector& simplified = session.simplified;
+    preprocessor.clear();
+    simplified.clear();
+    if (options.preprocess) {
+      preprocessor.run(session.formula, session.formula.getVariables().size(), simplified);
+    }
+    session.solver.load(options.preprocess ? simplified : session.formula, session.formula.getVariables());
+    if (!session.solver.solve()) {
+      return 'u';
+    }
+    std::vector<Variable>& vars = session.solver.getVariables();
+    preprocessor.extendModel(vars);
+    for (size_t v = 0; v < vars.size(); ++v) {
+      response += vars[v].getAssignment() ? "" : "-";
+      response += std::to_string(v + 1);
+      response += ' ';
+    }
+    response += "0\n";
+    return 's';
+  }
+  if (kind == 'a' || kind == 'q') {
+    CDCLSolver& solver = session.incremental;
+    std::vector<int>& lits = session.lits;
+    if (!parseLiterals(payload, lits, kind == 'a')) {
+      response = "bad literals\n";
+      return 'e';
+    }
+    for (int lit : lits) {
+      while (lit >= 0 && litVar(lit) >= solver.numVars()) {
+        solver.newVar("x" + std::to_string(solver.numVars() + 1));
+      }
+    }
+    if (kind == 'a') {
+      std::vector<int> clause;
+      for (int lit : lits) {
+        if (lit >= 0) {
+          clause.push_back(lit);
+        } else {
+          solver.addClause(clause);
+          clause.clear();
+        }
+      }
+      return 'o';
+    }
+    if (!solver.solve(lits)) {
+      for (int lit : solver.getFailedAssumptions()) {
+        response += litSign(lit) ? "-" : "";
+        response += std::to_string(litVar(lit) + 1);
+        response += ' ';
+      }
+      response += "0\n";
+      return 'u';
+    }
+    for (int v = 0; v < solver.numVars(); ++v) {
+      response += solver.modelValue(mkLit(v, false)) ? "" : "-";
+      response += std::to_string(v + 1);
+      response += ' ';
+    }
+    response += "0\n";
+    return 's';
+  }
+  if (kind == 'r') {
+    ClauseVector empty;
+    session.incremental.load(empty, std::vector<Variable>());
+    return 'o';
+  }
+  if (kind == 't') {
+    std::ostringstream line;
+    getStatistics().print(line);
+    response = line.str();
+    return 't';
+  }
+  if (kind == 'x') {
+    stopping = true;
+    return 'o';
+  }
+  response = "unknown request\n";
+  return 'e';
+}
+
+bool SolverServer::serve(Connection& conn, Session& session) {
+  std::string header;
+  std::string payload;
+  while (!stopping && readLine(conn, header)) {
+    double start = wallTime();
+    char kind = header.empty() ? ' ' : header[0];
+    char* end = nullptr;
+    long long size = header.size() > 2 && header[1] == ' ' ? std::strtoll(header.c_str() + 2, &end, 10) : -1;
+    if (size < 0 || end == nullptr || *end != '\0') {
+      // the rest of the stream cannot be framed any more //
+      writeFrame(conn, 'e', "bad header\n");
+      std::lock_guard<std::mutex> guard(statsLock);
+      stats.errors++;
+      break;
+    }
+    if (!readPayload(conn, payload, size)) {
+      break;
+    }
+    char result = answer(kind, payload, session);
+    bool written = writeFrame(conn, result, session.response);
+    {
+      std::lock_guard<std::mutex> guard(statsLock);
+      stats.requests++;
+      stats.satisfiable += result == 's';
+      stats.unsatisfiable += result == 'u';
+      stats.errors += result == 'e';
+      stats.latencies.push_back(wallTime() - start);
+    }
+    if (!written) {
+      break;
+    }
+  }
+  return !stopping;
+}
+
+void SolverServer::runStdio() {
+  Session session(options);
+  Connection conn(0, 1);
+  serve(conn, session);
+}
+
+void SolverServer::work() {
+  Session session(options);
+  while (!stopping) {
+    int fd = accept(listenFd, nullptr, nullptr);
+    if (fd < 0) {
+      if (errno == EINTR || errno == ECONNABORTED) {
+        continue;
+      }
+      break;
+    }
+    Connection conn(fd, fd);
+    bool running = serve(conn, session);
+    close(fd);
+    if (!running) {
+      shutdown(listenFd, SHUT_RDWR); // wakes the workers waiting in accept //
+    }
+  }
+}
+
+bool SolverServer::runSocket(const std::string& path) {
+  sockaddr_un address;
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(address.sun_path)) {
+    std::cerr << "Socket path too long: " << path << std::endl;
+    return false;
+  }
+  std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+  // only a stale socket is replaced, any other file at the path is left alone //
+  struct stat info;
+  if (lstat(path.c_str(), &info) == 0 && (!S_ISSOCK(info.st_mode) || unlink(path.c_str()) != 0)) {
+    std::cerr << "Unable to listen on socket: " << path << std::endl;
+    return false;
+  }
+  listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listenFd < 0 || bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0
+      || listen(listenFd, 64) < 0) {
+    std::cerr << "Unable to listen on socket: " << path << std::endl;
+    if (listenFd >= 0) {
+      close(listenFd);
+    }
+    return false;
+  }
+  // a client going away must not kill the server //
+  signal(SIGPIPE, SIG_IGN);
+  std::vector<std::thread> workers;
+  for (int i = 0; i < options.threads; ++i) {
+    workers.emplace_back(&SolverServer::work, this);
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  close(listenFd);
+  unlink(path.c_str());
+  return true;
+}
+
+//                                        *************** Aiger ******************** //
+
+bool Aiger::detect(const std::string& filename) {
+  // only regular files are looked at, the header of a pipe would be gone afterwards //
+  struct stat info;
+  if (stat(filename.c_str(), &info) != 0 || !S_ISREG(info.st_mode)) {
+    return false;
+  }
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  char magic[4];
+  bool aiger = read(fd, magic, 4) == 4 && (std::memcmp(magic, "aag ", 4) == 0 || std::memcmp(magic, "aig ", 4) == 0);
+  close(fd);
+  return aiger;
+}
+
+bool Aiger::readFromFile(const std::string& filename) {
+  if (netlists.size() == 2) {
+    std::cerr << "A miter takes two netlists" << std::endl;
+    return false;
+  }
+  double start = wallTime();
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    std::cerr << "Unable to open file: " << filename << std::endl;
+    return false;
+  }
+  std::vector<char> buffer;
+  char chunk[1 << 16];
+  ssize_t n;
+  while ((n = read(fd, chunk, sizeof(chunk))) > 0) {
+    buffer.insert(buffer.end(), chunk, chunk + n);
+  }
+  close(fd);
+  netlists.emplace_back();
+  bool result = parse(buffer.data(), buffer.size(), netlists.back());
+  stats.parseTime += wallTime() - start;
+  return result;
+}
+
+bool Aiger::parse(const char* p, size_t size, Netlist& netlist) {
+  const char* end = p + size;
+  lineNumber = 1;
+  const char* header = p;
+  while (p < end && *p != '\n') {
+    p++;
+  }
+  std::istringstream line(std::string(header, p));
+  if (p < end) {
+    p++;
+  }
+  std::string format;
+  std::vector<unsigned long long> counts;
+  unsigned long long count;
+  line >> format;
+  while (line >> count) {
+    counts.push_back(count);
+  }
+  if ((format != "aag" && format != "aig") || !line.eof() || counts.size() < 5 || counts.size() > 9) {
+    return parseError("AIGER header \"aag|aig M I L O A\" expected");
+  }
+  counts.resize(9, 0);
+  for (unsigned long long c : counts) {
+    if (c > (1 << 28)) {
+      return parseError("count out of range");
+    }
+  }
+  if (counts[7] != 0 || counts[8] != 0) {
+    return parseError("justice and fairness properties are not supported");
+  }
+  bool binary = format == "aig";
+  unsigned maxVar = counts[0], numInputs = counts[1], numLatches = counts[2], numAnds = counts[4];
+  unsigned numOutputs = counts[3] + counts[5]; // bad state properties are checked like outputs //
+  unsigned numConstraints = counts[6];
+  if (binary ? maxVar != numInputs + numLatches + numAnds : maxVar < numInputs + numLatches + numAnds) {
+    return parseError("M does not match I + L + A");
+  }
+  netlist.maxVar = maxVar;
+  netlist.latches = numLatches;
+  std::vector<char> defined(maxVar + 1, 0);
+  // a literal that inputs, latches and gates may define: positive, in range, not defined before //
+  auto define = [&](unsigned lit) {
+    if ((lit & 1) != 0 || lit < 2 || lit > 2 * maxVar || defined[lit >> 1]) {
+      return false;
+    }
+    defined[lit >> 1] = 1;
+    return true;
+  };
+  unsigned values[3];
+  for (unsigned i = 0; i < numInputs; ++i) {
+    unsigned lit = 2 * (i + 1);
+    if (!binary) {
+      if (readNumbers(p, end, values, 1) != 1) {
+        return parseError("input literal expected");
+      }
+      lit = values[0];
+    }
+    if (!define(lit)) {
+      return parseError("bad or repeated input literal");
+    }
+    netlist.inputs.push_back(lit);
+  }
+  for (unsigned i = 0; i < numLatches; ++i) {
+    // the next state and the reset value are not needed, latches are free inputs //
+    unsigned lit = 2 * (numInputs + i + 1);
+    int numbers = readNumbers(p, end, values, 3);
+    if (binary ? numbers < 1 || numbers > 2 : numbers < 2) {
+      return parseError("latch expected");
+    }
+    if (!binary) {
+      lit = values[0];
+    }
+    if (!define(lit)) {
+      return parseError("bad or repeated latch literal");
+    }
+    netlist.inputs.push_back(lit);
+  }
+  for (unsigned i = 0; i < numOutputs + numConstraints; ++i) {
+    if (readNumbers(p, end, values, 1) != 1 || values[0] > 2 * maxVar + 1) {
+      return parseError("output literal expected");
+    }
+    (i < numOutputs ? netlist.outputs : netlist.constraints).push_back(values[0]);
+  }
+  for (unsigned i = 0; i < numAnds; ++i) {
+    unsigned lhs = 2 * (numInputs + numLatches + i + 1);
+    unsigned rhs0, rhs1;
+    if (binary) {
+      // the gates follow their fanins, only the differences lhs - rhs0 and rhs0 - rhs1 are stored //
+      unsigned delta0, delta1;
+      if (!readDelta(p, end, delta0) || !readDelta(p, end, delta1) || delta0 == 0 || delta0 > lhs
+          || delta1 > lhs - delta0) {
+        return parseError("bad binary AND gate " + std::to_string(i));
+      }
+      rhs0 = lhs - delta0;
+      rhs1 = rhs0 - delta1;
+    } else {
+      if (readNumbers(p, end, values, 3) != 3 || values[1] > 2 * maxVar + 1 || values[2] > 2 * maxVar + 1) {
+        return parseError("AND gate expected");
+      }
+      lhs = values[0];
+      rhs0 = values[1];
+      rhs1 = values[2];
+    }
+    if (!define(lhs)) {
+      return parseError("bad or repeated AND gate literal");
+    }
+    netlist.gates.push_back(lhs);
+    netlist.gates.push_back(rhs0);
+    netlist.gates.push_back(rhs1);
+  }
+  // symbol table up to the comment section: "i<position> name" and the like //
+  netlist.names.resize(netlist.inputs.size());
+  while (p < end) {
+    lineNumber++;
+    const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', end - p));
+    if (lineEnd == nullptr) {
+      lineEnd = end;
+    }
+    const char* nameEnd = lineEnd > p && lineEnd[-1] == '\r' ? lineEnd - 1 : lineEnd;
+    if (*p == 'c' && nameEnd == p + 1) {
+      break; // comments follow //
+    }
+    if (nameEnd > p) {
+      char kind = *p;
+      const char* q = p + 1;
+      unsigned long long position = 0;
+      while (q < nameEnd && *q >= '0' && *q <= '9' && position <= (1 << 28)) {
+        position = position * 10 + (*q++ - '0');
+      }
+      if (std::strchr("ilobcjf", kind) == nullptr || q == p + 1 || q == nameEnd || *q != ' ') {
+        return parseError("symbol table entry expected");
+      }
+      if (kind == 'i' && position < numInputs) {
+        netlist.names[position].assign(q + 1, nameEnd);
+      } else if (kind == 'l' && position < numLatches) {
+        netlist.names[numInputs + position].assign(q + 1, nameEnd);
+      }
+    }
+    p = lineEnd < end ? lineEnd + 1 : end;
+  }
+  return true;
+}
+
+bool Aiger::parseError(const std::string& message) {
+  std::cerr << "AIGER parse error at line " << lineNumber << ": " << message << std::endl;
+  return false;
+}
+
+int Aiger::readNumbers(const char*& p, const char* end, unsigned* values, int most) {
+  int count = 0;
+  lineNumber++;
+  while (true) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+      p++;
+    }
+    if (p == end || *p == '\n') {
+      break;
+    }
+    if (count == most || *p < '0' || *p > '9') {
+      return -1;
+    }
+    unsigned long long value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+      value = value * 10 + (*p - '0');
+      if (value > 0xffffffffULL) {
+        return -1;
+      }
+      p++;
+    }
+    values[count++] = value;
+  }
+  if (p < end) {
+    p++;
+  }
+  return count;
+}
+
+bool Aiger::readDelta(const char*& p, const char* end, unsigned& delta) {
+  delta = 0;
+  for (int shift = 0; shift < 32; shift += 7) {
+    if (p == end) {
+      return false;
+    }
+    unsigned char c = *p++;
+    if (shift == 28 && (c & 0x70) != 0) {
+      return false; // more than 32 bits //
+    }
+    delta |= (unsigned)(c & 0x7f) << shift;
+    if ((c & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+int Aiger::mkAnd(int a, int b) {
+  if (a > b) {
+    std::swap(a, b);
+  }
+  // the constants are the smallest literals //
+  if (a == 0 || a == litNeg(b)) {
+    stats.hashedGates++;
+    return 0;
+  }
+  if (a == 1 || a == b) {
+    stats.hashedGates++;
+    return b;
+  }
+  uint64_t key = (uint64_t)a << 32 | (uint32_t)b;
+  auto it = strash.find(key);
+  if (it != strash.end()) {
+    stats.hashedGates++;
+    return it->second;
+  }
+  int lit = mkLit(fanins.size() / 2, false);
+  fanins.push_back(a);
+  fanins.push_back(b);
+  strash.emplace(key, lit);
+  return lit;
+}
+
+bool Aiger::build(const Netlist& netlist, const std::vector<unsigned>& roots, std::vector<int>& hashed) {
+  // map[v]: hashed literal of netlist variable v, -1 while not built and -2 while its fanins are //
+  std::vector<int> map(netlist.maxVar + 1, -1);
+  std::vector<int> definition(netlist.maxVar + 1, -1);
+  map[0] = 0;
+  for (size_t k = 0; k < netlist.inputs.size(); ++k) {
+    map[netlist.inputs[k] >> 1] = mkLit(k + 1, false);
+  }
+  for (size_t g = 0; g < netlist.gates.size(); g += 3) {
+    definition[netlist.gates[g] >> 1] = g;
+  }
+  std::vector<unsigned> stack;
+  hashed.clear();
+  for (unsigned root : roots) {
+    stack.push_back(root >> 1);
+    while (!stack.empty()) {
+      unsigned var = stack.back();
+      if (map[var] >= 0) {
+        stack.pop_back();
+        continue;
+      }
+      int g = definition[var];
+      if (g < 0) {
+        std::cerr << "AIGER literal " << 2 * var << " is used but not defined" << std::endl;
+        return false;
+      }
+      unsigned a = netlist.gates[g + 1], b = netlist.gates[g + 2];
+      if (map[var] == -1) {
+        // first visit: the fanins go first. A fanin still waiting for its own fanins is on the path to here //
+        map[var] = -2;
+        for (unsigned fanin : {a, b}) {
+          if (map[fanin >> 1] == -2) {
+            std::cerr << "AIGER combinational cycle through literal " << 2 * var << std::endl;
+            return false;
+          }
+          if (map[fanin >> 1] == -1) {
+            stack.push_back(fanin >> 1);
+          }
+        }
+        continue;
+      }
+      stack.pop_back();
+      map[var] = mkAnd(map[a >> 1] ^ (a & 1), map[b >> 1] ^ (b & 1));
+    }
+    hashed.push_back(map[root >> 1] ^ (root & 1));
+  }
+  return true;
+}
+
+bool Aiger::encode(const std::vector<int>& outputs, ClauseVector& formula) {
+  double start = wallTime();
+  const Netlist& first = netlists[0];
+  for (const Netlist& netlist : netlists) {
+    if (netlist.inputs.size() != first.inputs.size() || netlist.latches != first.latches
+        || netlist.outputs.size() != first.outputs.size()) {
+      std::cerr << "A miter needs netlists with the same numbers of inputs, latches and outputs" << std::endl;
+      return false;
+    }
+  }
+  std::vector<int> selected(outputs);
+  if (selected.empty()) {
+    for (size_t o = 0; o < first.outputs.size(); ++o) {
+      selected.push_back(o);
+    }
+  }
+  for (int o : selected) {
+    if (o < 0 || o >= (int)first.outputs.size()) {
+      std::cerr << "Output " << o << " does not exist, the netlist has " << first.outputs.size() << std::endl;
+      return false;
+    }
+  }
+  numInputs = first.inputs.size();
+  fanins.assign(2 * (numInputs + 1), 0);
+  strash.clear();
+
+  // the checked outputs, XOR-ed pairwise for a miter, and the constraints as hashed literals //
+  std::vector<int> checked;
+  std::vector<int> assumed;
+  std::vector<std::vector<int>> hashedOutputs(netlists.size());
+  std::vector<int> hashed;
+  for (size_t n = 0; n < netlists.size(); ++n) {
+    const Netlist& netlist = netlists[n];
+    std::vector<unsigned> roots;
+    for (int o : selected) {
+      roots.push_back(netlist.outputs[o]);
+    }
+    roots.insert(roots.end(), netlist.constraints.begin(), netlist.constraints.end());
+    if (!build(netlist, roots, hashed)) {
+      return false;
+    }
+    stats.fileGates += netlist.gates.size() / 3;
+    hashedOutputs[n].assign(hashed.begin(), hashed.begin() + selected.size());
+    assumed.insert(assumed.end(), hashed.begin() + selected.size(), hashed.end());
+  }
+  for (size_t k = 0; k < selected.size(); ++k) {
+    checked.push_back(netlists.size() == 1 ? hashedOutputs[0][k] : mkXor(hashedOutputs[0][k], hashedOutputs[1][k]));
+  }
+
+  // the cone of influence of what is left after hashing, nodes come after their fanins //
+  int numNodes = fanins.size() / 2;
+  std::vector<char> cone(numNodes, 0);
+  for (const std::vector<int>* roots : {&checked, &assumed}) {
+    for (int lit : *roots) {
+      cone[litVar(lit)] = 1;
+    }
+  }
+  for (int node = numNodes - 1; node > numInputs; --node) {
+    if (cone[node]) {
+      cone[litVar(fanins[2 * node])] = 1;
+      cone[litVar(fanins[2 * node + 1])] = 1;
+    }
+  }
+
+  // every input gets a variable, first, so the model starts with them //
+  std::vector<int> variable(numNodes, -1);
+  for (int k = 0; k < numInputs; ++k) {
+    std::string name = first.names[k];
+    if (name.empty() && netlists.size() > 1) {
+      name = netlists[1].names[k];
+    }
+    if (name.empty()) {
+      int latch = k - (numInputs - (int)first.latches);
+      name = latch < 0 ? "i" + std::to_string(k) : "l" + std::to_string(latch);
+    }
+    variable[k + 1] = formula.addVariable(name);
+  }
+  auto cnfLit = [&](int lit) { return mkLit(variable[litVar(lit)], litSign(lit)); };
+  for (int node = numInputs + 1; node < numNodes; ++node) {
+    if (!cone[node]) {
+      continue;
+    }
+    // g = a & b: (gbar + a)(gbar + b)(g + abar + bbar) //
+    variable[node] = formula.addVariable("n" + std::to_string(node));
+    int g = mkLit(variable[node], false);
+    int a = cnfLit(fanins[2 * node]);
+    int b = cnfLit(fanins[2 * node + 1]);
+    int clause[3] = {litNeg(g), a};
+    formula.addClause(clause, 2);
+    clause[1] = b;
+    formula.addClause(clause, 2);
+    clause[0] = g;
+    clause[1] = litNeg(a);
+    clause[2] = litNeg(b);
+    formula.addClause(clause, 3);
+    stats.coneGates++;
+  }
+  // the constraints hold, and one checked output is true unless one is true anyway //
+  for (int lit : assumed) {
+    if (lit == 0) {
+      formula.addClause(nullptr, 0);
+    } else if (lit != 1) {
+      int unit = cnfLit(lit);
+      formula.addClause(&unit, 1);
+    }
+  }
+  std::vector<int> clause;
+  bool always = false;
+  for (int lit : checked) {
+    always = always || lit == 1;
+    if (lit > 1) {
+      clause.push_back(cnfLit(lit));
+    }
+  }
+  if (!always) {
+    formula.addClause(clause.data(), clause.size());
+  }
+  stats.inputs = numInputs;
+  stats.outputs = selected.size();
+  stats.clauses = formula.getSize();
+  stats.encodeTime = wallTime() - start;
+  return true;
+}
@@ -0,0 +1,1769 @@
+// athanasia karanika                                                               //
+// conflict driven clause learning solver, usable as a library (libcdcl.a):          //
+//   CDCLSolver solver;                                                              //
+//   int a = solver.newVar("a"), b = solver.newVar("b");                           //
+//   solver.addClause({mkLit(a, false), mkLit(b, false)});                           //
+//   solver.solve({mkLit(a, true)});   // solve under the assumption abar          //
+// clauses may be added between solve() calls and learnt clauses are kept, which   //
+// suits series of closely related queries such as bounded model checking           //
+#ifndef CDCL_SOLVER_H
+#define CDCL_SOLVER_H
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <algorithm>
+#include <utility>
+#include <random>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <chrono>
+#include <atomic>
+#include <memory>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+// trace output is compiled out entirely with -DCDCL_NO_TRACE, otherwise the statement //
+// runs when the verbosity is at least the given level                                 //
+#ifdef CDCL_NO_TRACE
+#define TRACE(verbosity, level, statement) do { } while (0)
+#else
+#define TRACE(verbosity, level, statement) do { if ((verbosity) >= (level)) { statement; } } while (0)
+#endif
+
+// verbosity levels: result and summary only, periodic progress lines, //
+// solver events (restarts, reductions), full search trace             //
+enum Verbosity { VERBOSITY_QUIET = 0, VERBOSITY_PROGRESS = 1, VERBOSITY_INFO = 2, VERBOSITY_TRACE = 3 };
+
+// wall clock time in seconds //
+inline double wallTime() {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// literals are packed as 2*variable + sign, where sign is 1 for the complemented (bar) literal //
+inline int mkLit(int var, bool sign) { return 2 * var + (sign ? 1 : 0); }
+inline int litVar(int lit) { return lit >> 1; }
+inline bool litSign(int lit) { return lit & 1; }
+inline int litNeg(int lit) { return lit ^ 1; }
+
+class Variable {
+  private:
+      std::string variable;
+      bool assignment;
+  public:
+      // Constructor to initialize variable
+      Variable(const std::string& var) : variable(var), assignment(false) {}
+
+      std::string getVariable() {
+          return variable;
+      }
+
+      bool getAssignment() {
+          return assignment;
+      }
+
+      void setAssignment(bool assign) {
+          assignment = assign;
+      }
+};
+
+// the parsed formula: packed literals of all clauses stored back to back, //
+// variable names are kept once in the variables table. Cardinality        //
+// constraints are kept apart, all of them as at-most-k constraints         //
+class ClauseVector {
+  private:
+      std::vector<int> literals;
+      std::vector<uint32_t> clauseStart; // clauseStart[i]: offset of clause i, the last entry is the end //
+      std::vector<int> cardLiterals;
+      std::vector<uint32_t> cardStart;   // cardStart[i]: offset of constraint i in cardLiterals, the last entry is the end //
+      std::vector<int> cardBounds;       // at most cardBounds[i] literals of constraint i are true //
+      std::vector<Variable> variables;
+      std::unordered_map<std::string, int> variableTable; // variable name -> index //
+      std::string nameBuffer;
+      int lineNumber;
+
+      static bool isBlank(char c) {
+          return c == ' ' || c == '\t' || c == '\r';
+      }
+
+      // literals of the form x1 + x3bar, one clause per line, //
+      // blank lines and lines starting with // are skipped.  //
+      // A line ending in <= k or >= k, as in x1 + x2 + x3 <= 1, //
+      // is a cardinality constraint instead of a clause         //
+      bool parseLines(const char* p, const char* end);
+
+      // standard DIMACS CNF: "p cnf <variables> <clauses>" followed by clauses of //
+      // non-zero integers terminated by 0, lines starting with c are comments.    //
+      // As in the cnf+ format, a line "1 -2 3 <= 1" is a cardinality constraint   //
+      bool parseDimacs(const char* p, const char* end);
+
+      // the "<= k" or ">= k" at p ends a cardinality constraint over the literals read since //
+      // the last clause. At least k of n literals is stored as at most n - k of their negations //
+      bool parseBound(const char*& p, const char* end);
+
+      // DIMACS variable n is named xn and has index n-1 //
+      int dimacsVariable(long long n);
+
+      bool parseError(const std::string& message);
+  public:
+      ClauseVector() : clauseStart(1, 0), cardStart(1, 0), lineNumber(1) {}
+
+      // index of the named variable, a new variable is created the first time a name is seen //
+      int getVariableIndex(const std::string& varName);
+
+      // a new variable even when the name is taken, for formulas built without parsing //
+      int addVariable(const std::string& varName);
+
+      // Method to add a clause of packed literals to the vector //
+      void addClause(const int* lits, int size);
+
+      // add the constraint that at most bound of the packed literals are true //
+      void addAtMost(const int* lits, int size, int bound);
+
+      // parse a formula held in memory, in DIMACS or in the x1 + x3bar syntax //
+      bool parse(const char* data, size_t size);
+
+      // Method to read clauses from a file and add them to the vector //
+      bool readClausesFromFile(const std::string& filename);
+
+      void print();
+
+      std::vector<Variable> extractVariables() {
+          return variables;
+      }
+
+      const std::vector<Variable>& getVariables() const {
+          return variables;
+      }
+
+      // forget the formula but keep the memory, for parsing the next one //
+      void clear() {
+          literals.clear();
+          clauseStart.assign(1, 0);
+          cardLiterals.clear();
+          cardStart.assign(1, 0);
+          cardBounds.clear();
+          variables.clear();
+          variableTable.clear();
+          lineNumber = 1;
+      }
+
+      std::string literalName(int lit) {
+          return variables[litVar(lit)].getVariable() + (litSign(lit) ? "bar" : "");
+      }
+
+      // the getters below only read, several solvers may share one ClauseVector //
+      int getSize() const {
+        return clauseStart.size() - 1;
+      }
+
+      int getClauseSize(int i) const {
+        return clauseStart[i + 1] - clauseStart[i];
+      }
+
+      const int* getClause(int i) const {
+        return literals.data() + clauseStart[i];
+      }
+
+      int getNumCardinalities() const {
+        return cardBounds.size();
+      }
+
+      int getCardinalitySize(int i) const {
+        return cardStart[i + 1] - cardStart[i];
+      }
+
+      const int* getCardinality(int i) const {
+        return cardLiterals.data() + cardStart[i];
+      }
+
+      int getCardinalityBound(int i) const {
+        return cardBounds[i];
+      }
+};
+
+// offset of a clause in the ClauseArena //
+typedef uint32_t CRef;
+const CRef CREF_UNDEF = 0xffffffff;
+const CRef CREF_BINARY = 0x80000000;
+const CRef CREF_CARD = 0xc0000000;
+
+// binary clauses are not stored in the arena. A literal implied by one has the other, false //
+// literal of the clause as its reason, tagged with the top bit so it is not an arena offset  //
+inline bool isBinaryReason(CRef ref) { return (ref & CREF_CARD) == CREF_BINARY; }
+inline CRef binaryReason(int lit) { return CREF_BINARY | lit; }
+inline int binaryReasonLit(CRef ref) { return ref & ~CREF_BINARY; }
+
+// a literal implied by a cardinality constraint has the constraint index tagged with the top two bits //
+inline bool isCardReason(CRef ref) { return ref != CREF_UNDEF && (ref & CREF_CARD) == CREF_CARD; }
+inline CRef cardReason(int index) { return CREF_CARD | index; }
+inline int cardReasonIndex(CRef ref) { return ref & ~CREF_CARD; }
+
+// a reason that is an offset in the ClauseArena //
+inline bool isClauseReason(CRef ref) { return (ref & CREF_BINARY) == 0; }
+
+// view of a clause stored in the ClauseArena: three header words followed by the packed literals //
+//   word 0: size << 4 | used << 3 | deleted << 2 | reloced << 1 | learnt                            //
+//   word 1: literal block distance (LBD), or the new offset once the clause has been relocated      //
+//   word 2: activity, stored as float bits                                                           //
+// views point into the arena memory and are invalidated by the next allocation                     //
+class Clause {
+  private:
+      uint32_t* data;
+  public:
+      static const int HEADER_WORDS = 3;
+
+      Clause(uint32_t* words) : data(words) {}
+
+      int size() const {
+        return data[0] >> 4;
+      }
+
+      bool learnt() const {
+        return data[0] & 1;
+      }
+
+      bool reloced() const {
+        return data[0] & 2;
+      }
+
+      bool deleted() const {
+        return data[0] & 4;
+      }
+
+      void markDeleted() {
+        data[0] |= 4;
+      }
+
+      // a learnt clause is used when it takes part in conflict analysis, see reduceDB //
+      bool used() const {
+        return data[0] & 8;
+      }
+
+      void setUsed(bool used) {
+        data[0] = used ? data[0] | 8 : data[0] & ~8u;
+      }
+
+      unsigned int lbd() const {
+        return data[1];
+      }
+
+      void setLbd(unsigned int lbd) {
+        data[1] = lbd;
+      }
+
+      float activity() const {
+        float act;
+        std::memcpy(&act, &data[2], sizeof(act));
+        return act;
+      }
+
+      void setActivity(float act) {
+        std::memcpy(&data[2], &act, sizeof(act));
+      }
+
+      CRef relocation() const {
+        return data[1];
+      }
+
+      void setRelocation(CRef ref) {
+        data[0] |= 2;
+        data[1] = ref;
+      }
+
+      int* literals() {
+        return reinterpret_cast<int*>(data + HEADER_WORDS);
+      }
+
+      int& operator[](int i) {
+        return literals()[i];
+      }
+
+      static size_t words(int size) {
+        return HEADER_WORDS + size;
+      }
+};
+
+// contiguous store of all clauses of the solver, clauses are addressed by 32-bit offsets. //
+// Freed clauses only count as wasted memory until the solver compacts the arena         //
+class ClauseArena {
+  private:
+      std::vector<uint32_t> memory;
+      size_t wastedWords;
+  public:
+      ClauseArena() : wastedWords(0) {}
+
+      CRef alloc(const int* lits, int size, bool learnt) {
+        CRef ref = memory.size();
+        memory.resize(memory.size() + Clause::words(size));
+        memory[ref] = (uint32_t)size << 4 | (learnt ? 9 : 0); // a new learnt clause counts as used //
+        Clause clause = (*this)[ref];
+        clause.setLbd(0);
+        clause.setActivity(0);
+        std::copy(lits, lits + size, clause.literals());
+        return ref;
+      }
+
+      Clause operator[](CRef ref) {
+        return Clause(&memory[ref]);
+      }
+
+      void free(CRef ref) {
+        Clause clause = (*this)[ref];
+        clause.markDeleted();
+        wastedWords += Clause::words(clause.size());
+      }
+
+      // move a live clause into the arena 'to', returns its new offset; //
+      // the old copy remembers it so every reference maps to one copy   //
+      CRef relocate(CRef ref, ClauseArena& to) {
+        Clause clause = (*this)[ref];
+        if (clause.reloced()) {
+          return clause.relocation();
+        }
+        CRef newRef = to.alloc(clause.literals(), clause.size(), clause.learnt());
+        Clause moved = to[newRef];
+        moved.setLbd(clause.lbd());
+        moved.setActivity(clause.activity());
+        moved.setUsed(clause.used());
+        clause.setRelocation(newRef);
+        return newRef;
+      }
+
+      size_t size() const {
+        return memory.size();
+      }
+
+      size_t wasted() const {
+        return wastedWords;
+      }
+
+      void reserve(size_t words) {
+        memory.reserve(words);
+      }
+
+      void clear() {
+        memory.clear();
+        wastedWords = 0;
+      }
+
+      void swap(ClauseArena& other) {
+        memory.swap(other.memory);
+        std::swap(wastedWords, other.wastedWords);
+      }
+};
+
+// binary max-heap of variables ordered by activity, indices[v] is the position of v in //
+// the heap or -1 when v is not in it                                                  //
+class VariableHeap {
+  private:
+    std::vector<int> heap;
+    std::vector<int> indices;
+    const std::vector<double>& activity;
+
+    void percolateUp(int i) {
+      int var = heap[i];
+      while (i > 0) {
+        int parent = (i - 1) >> 1;
+        if (activity[heap[parent]] >= activity[var]) {
+          break;
+        }
+        heap[i] = heap[parent];
+        indices[heap[i]] = i;
+        i = parent;
+      }
+      heap[i] = var;
+      indices[var] = i;
+    }
+
+    void percolateDown(int i) {
+      int var = heap[i];
+      int size = heap.size();
+      while (2 * i + 1 < size) {
+        int child = 2 * i + 1;
+        if (child + 1 < size && activity[heap[child + 1]] > activity[heap[child]]) {
+          child++;
+        }
+        if (activity[heap[child]] <= activity[var]) {
+          break;
+        }
+        heap[i] = heap[child];
+        indices[heap[i]] = i;
+        i = child;
+      }
+      heap[i] = var;
+      indices[var] = i;
+    }
+  public:
+    VariableHeap(const std::vector<double>& act) : activity(act) {}
+
+    void clear() {
+      for (int var : heap) {
+        indices[var] = -1;
+      }
+      heap.clear();
+    }
+
+    bool empty() const {
+      return heap.empty();
+    }
+
+    int size() const {
+      return heap.size();
+    }
+
+    int at(int i) const {
+      return heap[i];
+    }
+
+    bool inHeap(int var) const {
+      return var < (int)indices.size() && indices[var] >= 0;
+    }
+
+    void insert(int var) {
+      if (var >= (int)indices.size()) {
+        indices.resize(var + 1, -1);
+      }
+      heap.push_back(var);
+      percolateUp(heap.size() - 1);
+    }
+
+    // restore the heap order after the activity of var was increased //
+    void increase(int var) {
+      percolateUp(indices[var]);
+    }
+
+    int removeMax() {
+      int var = heap[0];
+      heap[0] = heap.back();
+      indices[heap[0]] = 0;
+      indices[var] = -1;
+      heap.pop_back();
+      if (heap.size() > 1) {
+        percolateDown(0);
+      }
+      return var;
+    }
+};
+
+// fixed size window over the last values pushed, with their running sum //
+class BoundedQueue {
+  private:
+    std::vector<unsigned int> values;
+    size_t first;
+    size_t count;
+    unsigned long long sum;
+  public:
+    BoundedQueue() : first(0), count(0), sum(0) {}
+
+    void init(size_t size) {
+      values.assign(size, 0);
+      clear();
+    }
+
+    void push(unsigned int value) {
+      if (count == values.size()) {
+        sum -= values[first];
+        values[first] = value;
+        first = (first + 1) % values.size();
+      } else {
+        values[(first + count) % values.size()] = value;
+        count++;
+      }
+      sum += value;
+    }
+
+    bool full() const {
+      return count == values.size();
+    }
+
+    double average() const {
+      return count == 0 ? 0.0 : (double)sum / count;
+    }
+
+    void clear() {
+      first = 0;
+      count = 0;
+      sum = 0;
+    }
+};
+
+// value of the Luby sequence 1 1 2 1 1 2 4 1 1 2 1 1 2 4 8 ... at position i (from 0) //
+inline double luby(int i) {
+  int size = 1, seq = 0;
+  while (size < i + 1) {
+    seq++;
+    size = 2 * size + 1;
+  }
+  while (size - 1 != i) {
+    size = (size - 1) >> 1;
+    seq--;
+    i = i % size;
+  }
+  return (double)(1LL << seq);
+}
+
+enum RestartPolicy { RESTART_NONE, RESTART_LUBY, RESTART_GLUCOSE };
+
+// polarity of the first decision on each variable //
+enum InitialPhase { PHASE_OCCURRENCE, PHASE_FALSE, PHASE_TRUE, PHASE_RANDOM };
+
+// how the local search picks the variable to flip in an unsatisfied clause //
+enum WalkAlgorithm { WALK_PROBSAT, WALK_WALKSAT };
+
+// tunable parameters of the solver, set from the command line //
+struct SolverOptions {
+    double varDecay;       // activity decay factor applied after every conflict //
+    double randomFreq;     // probability of a random decision instead of the most active variable //
+    unsigned int seed;     // seed of the random decisions //
+    int reduceFirst;       // conflicts before the first learnt clause database reduction //
+    int reduceInc;         // growth of the interval between two reductions, in conflicts //
+    unsigned int coreLbd;  // learnt clauses with an LBD up to this are kept while they take part in conflicts //
+    RestartPolicy restartPolicy;
+    int lubyUnit;          // conflicts per unit of the Luby sequence //
+    int glucoseWindow;     // number of recent LBDs averaged by the Glucose policy //
+    double glucoseK;       // restart when the recent average times K exceeds the global average //
+    bool phaseSaving;      // decide variables with the polarity they had when last unassigned //
+    InitialPhase initialPhase;
+    int verbosity;         // see Verbosity //
+    int progressInterval;  // conflicts between two progress lines //
+    int threads;           // number of portfolio solvers //
+    unsigned int shareLbd; // learnt clauses up to this LBD are shared between portfolio solvers //
+    bool preprocess;       // simplify the formula before search, see Preprocessor //
+    int elimOccurrences;   // variables occurring in more clauses than this are not eliminated //
+    bool cubeAndConquer;   // split the formula into cubes solved in parallel instead of a portfolio //
+    int cubes;             // number of cubes the lookahead aims for, 0 for 8 per thread //
+    int cubeConflicts;     // conflicts spent on a cube before it is split again //
+    bool walk;             // local search bursts at restarts, their best assignment becomes the saved phases //
+    double walkEffort;     // flips of a burst per propagation since the previous burst //
+    WalkAlgorithm walkAlgorithm;
+    long long walkFlips;   // flips of the standalone local search //
+
+    SolverOptions() : varDecay(0.95), randomFreq(0.0), seed(91648253), reduceFirst(2000), reduceInc(300), coreLbd(6),
+                      restartPolicy(RESTART_GLUCOSE), lubyUnit(100), glucoseWindow(50), glucoseK(0.8), phaseSaving(true),
+                      initialPhase(PHASE_OCCURRENCE), verbosity(VERBOSITY_PROGRESS), progressInterval(10000), threads(1),
+                      shareLbd(3), preprocess(true), elimOccurrences(32), cubeAndConquer(false), cubes(0),
+                      cubeConflicts(10000), walk(true), walkEffort(0.3), walkAlgorithm(WALK_PROBSAT),
+                      walkFlips(100000000) {}
+};
+
+// counters kept by the solver, all times are in seconds //
+struct SolverStatistics {
+    long long decisions;
+    long long propagations;     // literals propagated //
+    long long conflicts;
+    long long learntLiterals;   // literals of the learnt clauses, after minimization //
+    long long minimizedLiterals; // literals removed by clause minimization //
+    long long restarts;
+    long long reductions;
+    long long deletedClauses;   // learnt clauses deleted by all reductions //
+    long long exportedClauses;  // learnt clauses sent to the other portfolio solvers //
+    long long importedClauses;  // clauses received from the other portfolio solvers //
+    long long equivalentVariables; // variables replaced in the clauses by an equivalent literal //
+    long long transitiveBinaries;  // binary clauses removed as implied by a path of other binaries //
+    long long walkBursts;       // local search runs between restarts //
+    long long walkFlips;
+    long long walkModels;       // bursts that satisfied every clause //
+    double parseTime;
+    double searchTime;
+    double propagateTime;
+    double analyzeTime;
+    double reduceTime;
+    double walkTime;
+
+    SolverStatistics() : decisions(0), propagations(0), conflicts(0), learntLiterals(0), minimizedLiterals(0), restarts(0),
+                         reductions(0), deletedClauses(0), exportedClauses(0), importedClauses(0), equivalentVariables(0),
+                         transitiveBinaries(0), walkBursts(0), walkFlips(0), walkModels(0), parseTime(0), searchTime(0),
+                         propagateTime(0), analyzeTime(0), reduceTime(0), walkTime(0) {}
+
+    // one line of key=value pairs, so runs can be compared by scripts //
+    void print(std::ostream& out, const std::string& prefix, double elapsed) const {
+      out << prefix << " decisions=" << decisions << " propagations=" << propagations << " conflicts=" << conflicts
+          << " learnt_literals=" << learntLiterals << " minimized_literals=" << minimizedLiterals
+          << " restarts=" << restarts << " reductions=" << reductions << " deleted_clauses=" << deletedClauses
+          << " exported_clauses=" << exportedClauses << " imported_clauses=" << importedClauses
+          << " equivalent_variables=" << equivalentVariables << " transitive_binaries=" << transitiveBinaries
+          << " walk_bursts=" << walkBursts << " walk_flips=" << walkFlips << " walk_models=" << walkModels
+          << " conflicts_per_sec=" << (long long)(elapsed > 0 ? conflicts / elapsed : 0)
+          << " props_per_sec=" << (long long)(elapsed > 0 ? propagations / elapsed : 0)
+          << " parse_time=" << parseTime << " search_time=" << searchTime << " propagate_time=" << propagateTime
+          << " analyze_time=" << analyzeTime << " reduce_time=" << reduceTime << " walk_time=" << walkTime << "\n";
+    }
+};
+
+// single producer / multiple consumer ring of short learnt clauses. Each slot is guarded //
+// by a sequence number that is odd while the producer writes it; a reader keeps its own  //
+// cursor, copies a slot and checks the sequence afterwards, so clauses overwritten before //
+// the reader got to them are skipped and nobody ever waits on a lock                     //
+class ClauseRing {
+  public:
+    static const int CAPACITY = 4096;
+    static const int MAX_SIZE = 8;
+  private:
+    struct Slot {
+      std::atomic<uint64_t> sequence; // 2n+1 while clause n is written, 2n+2 once it is complete //
+      std::atomic<uint32_t> size;
+      std::atomic<uint32_t> lbd;
+      std::atomic<int> lits[MAX_SIZE];
+    };
+    std::unique_ptr<Slot[]> slots;
+    std::atomic<uint64_t> head; // number of clauses pushed so far //
+  public:
+    ClauseRing() : slots(new Slot[CAPACITY]), head(0) {
+      for (int i = 0; i < CAPACITY; ++i) {
+        slots[i].sequence.store(0, std::memory_order_relaxed);
+      }
+    }
+
+    // only called by the owning solver //
+    void push(const int* lits, int size, unsigned int lbd) {
+      uint64_t n = head.load(std::memory_order_relaxed);
+      Slot& slot = slots[n % CAPACITY];
+      slot.sequence.store(2 * n + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      slot.size.store(size, std::memory_order_relaxed);
+      slot.lbd.store(lbd, std::memory_order_relaxed);
+      for (int i = 0; i < size; ++i) {
+        slot.lits[i].store(lits[i], std::memory_order_relaxed);
+      }
+      slot.sequence.store(2 * n + 2, std::memory_order_release);
+      head.store(n + 1, std::memory_order_release);
+    }
+
+    // copy the next clause after cursor into lits, returns false when there is none //
+    bool read(uint64_t& cursor, std::vector<int>& lits, unsigned int& lbd) {
+      while (true) {
+        uint64_t available = head.load(std::memory_order_acquire);
+        if (cursor >= available) {
+          return false;
+        }
+        if (available - cursor > CAPACITY) {
+          cursor = available - CAPACITY; // the oldest clauses were overwritten //
+        }
+        uint64_t n = cursor++;
+        Slot& slot = slots[n % CAPACITY];
+        uint64_t before = slot.sequence.load(std::memory_order_acquire);
+        if (before != 2 * n + 2) {
+          continue;
+        }
+        int size = slot.size.load(std::memory_order_relaxed);
+        lbd = slot.lbd.load(std::memory_order_relaxed);
+        lits.resize(size);
+        for (int i = 0; i < size; ++i) {
+          lits[i] = slot.lits[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == before) {
+          return true;
+        }
+      }
+    }
+};
+
+// a clause watching a literal, together with a blocker literal of the same clause:       //
+// if the blocker is already true the clause is satisfied and need not be visited at all  //
+struct Watcher {
+    CRef cref;
+    int blocker;
+
+    Watcher(CRef ref, int blk) : cref(ref), blocker(blk) {}
+
+    Watcher() : cref(CREF_UNDEF), blocker(0) {}
+};
+
+// at most bound of the literals cardLiterals[start .. start + size) are true. count is the number of //
+// true literals propagation has counted so far: the constraint is visited only when one of its      //
+// literals becomes true, once the count reaches the bound the unassigned literals are made false    //
+// and a count above it is a conflict                                                                //
+struct CardConstraint {
+    uint32_t start;
+    int size;
+    int bound;
+    int count;
+
+    CardConstraint(uint32_t first, int length, int atMost) : start(first), size(length), bound(atMost), count(0) {}
+};
+
+// stochastic local search over complete assignments. ProbSAT picks the variable to flip in a //
+// random unsatisfied clause with a probability falling with its break count (the clauses it  //
+// would leave unsatisfied), WalkSAT takes a break free variable, else a random one with       //
+// probability 0.567, else one with the fewest breaks. Break counts, the number of true        //
+// literals of every clause and the set of unsatisfied clauses are updated on each flip, the  //
+// true variables of a clause are kept xor-ed together so the only one is known at once       //
+class LocalSearch {
+  private:
+    SolverOptions options;
+    int numVars;
+    std::vector<int> literals;          // clauses back to back //
+    std::vector<uint32_t> clauseStart;  // clauseStart[c]: offset of clause c, the last entry is the end //
+    std::vector<uint32_t> occurStart;   // occurrences of literal l: occurs[occurStart[l] .. occurStart[l + 1]] //
+    std::vector<uint32_t> occurs;
+    bool prepared;                      // occurrence lists match the clauses //
+    std::vector<char> values;           // per variable, 1 true //
+    std::vector<int> breaks;
+    std::vector<uint32_t> trueCount;    // per clause //
+    std::vector<int> trueVars;          // per clause: xor of its true variables //
+    std::vector<uint32_t> unsat;        // unsatisfied clauses //
+    std::vector<int> unsatIndex;        // per clause: position in unsat, -1 when satisfied //
+    std::vector<double> probability;    // ProbSAT weight by break count //
+    std::vector<double> weights;
+    std::vector<int> sinceBest;         // variables flipped after the best assignment so far //
+    std::vector<char> odd;              // scratch for compacting sinceBest, all 0 between uses //
+    std::mt19937 randomGenerator;
+    long long flips;
+
+    void prepare();
+
+    void flip(int var);
+
+    int pickProbSat(uint32_t clause);
+
+    int pickWalkSat(uint32_t clause);
+  public:
+    LocalSearch(const SolverOptions& opts) : options(opts), numVars(0), clauseStart(1, 0), prepared(false),
+                                             randomGenerator(opts.seed), flips(0) {}
+
+    // forget the clauses, the next ones are over numVariables variables //
+    void reset(int numVariables) {
+      numVars = numVariables;
+      literals.clear();
+      clauseStart.assign(1, 0);
+      prepared = false;
+    }
+
+    // tautologies are left out //
+    void addClause(const int* lits, int size);
+
+    // search from assignment (per variable, 1 true) for at most maxFlips flips and leave the //
+    // best assignment seen in it. Returns its number of unsatisfied clauses                   //
+    int run(std::vector<char>& assignment, long long maxFlips);
+
+    // fill assignment with random values //
+    void randomAssignment(std::vector<char>& assignment) {
+      assignment.resize(numVars);
+      for (int v = 0; v < numVars; ++v) {
+        assignment[v] = randomGenerator() & 1;
+      }
+    }
+
+    long long getFlips() {
+      return flips;
+    }
+};
+
+// binary DRAT proof output: every added clause is written as 'a', every deleted clause as 'd', //
+// followed by its literals as variable-byte numbers 2 * (variable + 1) + sign and a 0 byte. The //
+// clauses go into a large buffer that a background thread writes out while the solver fills     //
+// the other one, so the file may be a pipe to a checker reading the proof on the fly. Variables  //
+// are numbered as in the DIMACS input, x1 + x3bar files in order of first appearance            //
+class ProofWriter {
+  private:
+    static const size_t BUFFER_SIZE = 1 << 20;
+    static const size_t MAX_CLAUSE_BYTES = 16; // per literal and for the 'a' and 0 bytes, at most 5 are used //
+
+    int fd;
+    std::vector<unsigned char> buffer;   // being filled by the solver //
+    size_t used;
+    std::vector<unsigned char> flushing; // being written by the flush thread //
+    size_t flushSize;
+    bool pending;                        // flushing holds data not written yet //
+    bool closing;
+    bool failed;
+    std::mutex lock;
+    std::condition_variable ready;       // signals the flush thread //
+    std::condition_variable done;        // signals the solver that flushing is free again //
+    std::thread flusher;
+    long long additions;
+    long long deletions;
+    long long bytes;
+
+    // write out the full buffer, waiting while the previous one is still being written //
+    void handOver();
+
+    void flushLoop();
+
+    void writeClause(unsigned char kind, const int* lits, int size) {
+      size_t needed = MAX_CLAUSE_BYTES * (size + 1);
+      if (used + needed > buffer.size()) {
+        handOver();
+        if (needed > buffer.size()) {
+          buffer.resize(needed); // a clause longer than the whole buffer //
+        }
+      }
+      unsigned char* p = buffer.data() + used;
+      *p++ = kind;
+      for (int i = 0; i < size; ++i) {
+        unsigned int u = lits[i] + 2;
+        while (u > 127) {
+          *p++ = (u & 127) | 128;
+          u >>= 7;
+        }
+        *p++ = u;
+      }
+      *p++ = 0;
+      used = p - buffer.data();
+    }
+  public:
+    ProofWriter() : fd(-1), buffer(BUFFER_SIZE), used(0), flushing(BUFFER_SIZE), flushSize(0), pending(false),
+                    closing(false), failed(false), additions(0), deletions(0), bytes(0) {}
+    ~ProofWriter();
+
+    // open the proof file (or pipe) and start the flush thread //
+    bool open(const std::string& filename);
+
+    // write out everything and stop the flush thread, false if a write failed //
+    bool close();
+
+    void addClause(const int* lits, int size) {
+      additions++;
+      writeClause('a', lits, size);
+    }
+
+    void addClause(const std::vector<int>& lits) {
+      addClause(lits.data(), lits.size());
+    }
+
+    void deleteClause(const int* lits, int size) {
+      deletions++;
+      writeClause('d', lits, size);
+    }
+
+    void deleteClause(const std::vector<int>& lits) {
+      deleteClause(lits.data(), lits.size());
+    }
+
+    void print(std::ostream& out) const {
+      out << "c proof added_clauses=" << additions << " deleted_clauses=" << deletions << " proof_bytes=" << bytes << "\n";
+    }
+};
+
+//                                        *************** CDCLSolver ********************                                                   //
+// 1) satisfy unit clauses and propagate to the rest of the clauses, e.g (x1)(x1bar+x2), x1=1(satisfy unit clause), x2=1(implied value)     //
+// 2) assignment: pick the most active variable (VSIDS) and assign it its preferred polarity                                                //
+// 2) if no conflict, propagate choice through the CNF finding implications                                                                 //
+// 3) if SAT all done, if a propagation leads to a conflict, 1st UIP is identified and conlfict clause is produced and added to the formula //
+//    and the search jumps back to the level where that clause becomes unit                                                                 //
+// 4) iterate all the above steps until SAT or UNSAT is proven                                                                              //
+class CDCLSolver{
+  private:
+    SolverOptions options;
+    std::vector<Variable> ownedVariables;      // names of the variables created with newVar //
+    std::vector<Variable>& variables;          // variable names, shared by all solvers of a portfolio //
+    std::vector<char> model;                   // per variable value of the last satisfying assignment //
+    ClauseArena arena;                         // every clause of size three or more lives here //
+    std::vector<std::vector<int>> implications; // implications[lit]: literals implied by binary clauses once lit is true //
+    long long binaryClauses;                   // binary clauses, each one is in two implication lists //
+    long long nextBinarySimplify;              // binary clause count of the next equivalence and transitive reduction pass //
+    std::vector<CRef> clauses;                 // original clauses //
+    std::vector<CRef> learnts;                 // learnt clauses //
+    bool ok;                                   // false once the formula is known to be unsatisfiable //
+    std::vector<int> trail;                    // assigned literals in assignment order //
+    std::vector<int> trailLim;                 // trailLim[l-1]: trail index where decision level l starts //
+    std::vector<std::vector<Watcher>> watches; // watches[lit]: clauses whose literal lit is watched //
+    std::vector<int> assigns;                  // per variable: 1 true, -1 false, 0 unassigned //
+    std::vector<int> level;                    // per variable: decision level of the assignment //
+    std::vector<CRef> reason;                  // per variable: implying clause or binaryReason(), CREF_UNDEF for decisions and level 0 units //
+    size_t qhead;                              // next trail entry to propagate through the long clauses //
+    size_t binaryHead;                         // next trail entry to propagate through the binary clauses //
+    int binaryConflictLit;                     // a conflict binaryReason(q) returned by propagate() is the clause binaryConflictLit + q //
+    int reasonBinary[2];                       // literals of a binary reason, see reasonLiterals //
+    std::vector<int> cardLiterals;             // literals of the cardinality constraints, back to back //
+    std::vector<CardConstraint> cards;
+    std::vector<std::vector<int>> cardOccurs;  // cardOccurs[lit]: constraints containing lit, once per occurrence //
+    size_t cardHead;                           // trail entries counted in the cardinality constraints //
+    std::vector<int> cardExplanation;          // clause of a cardinality reason or conflict, see explainCard //
+    size_t simplifyAssigns;                    // level 0 assignments when satisfied clauses were last removed //
+    std::vector<char> seen;                    // per variable marks used by conflict analysis //
+    std::vector<int> analyzeStack;
+    std::vector<int> analyzeToClear;
+    std::vector<int> addBuffer;                // scratch copy of a clause being added //
+    std::vector<double> activity;              // per variable VSIDS activity //
+    double varInc;                             // amount added to an activity on a bump //
+    VariableHeap orderHeap;                    // unassigned variables ordered by activity //
+    std::vector<char> polarity;                // per variable: 1 when decided as the bar literal //
+    std::mt19937 randomGenerator;
+    double claInc;                             // amount added to a learnt clause activity on a bump //
+    std::vector<unsigned int> levelStamp;      // per decision level marks used to compute LBDs //
+    unsigned int stamp;
+    SolverStatistics stats;
+    double searchStart;                        // wall time when solve() was called //
+    long long nextReduce;                      // conflict count of the next learnt clause database reduction //
+    long long nextProgress;                    // conflict count of the next progress line //
+    long long conflictsSinceRestart;
+    BoundedQueue recentLbds;                   // LBDs of the last learnt clauses, for Glucose restarts //
+    unsigned long long sumLbd;                 // sum of the LBDs of all learnt clauses //
+    ClauseRing* exportRing;                    // portfolio sharing, see setSharing //
+    std::vector<ClauseRing*> importRings;
+    std::vector<uint64_t> importCursors;
+    std::vector<int> importBuffer;
+    const std::atomic<bool>* stopFlag;         // solve() gives up once this is set //
+    std::vector<int> assumptions;              // literals decided first, one per level, by the current solve() //
+    std::vector<int> conflict;                 // failed assumption core of the last unsatisfiable solve() //
+    long long conflictLimit;                   // solve() gives up at this conflict count, -1 for no limit //
+    ProofWriter* proof;                        // DRAT output of learnt and deleted clauses, or nullptr //
+    std::unique_ptr<LocalSearch> walker;       // created by the first local search burst //
+    std::vector<char> walkAssignment;
+    long long nextWalk;                        // restart count of the next local search burst //
+    long long walkPropagations;                // propagations when the last burst ended //
+  public:
+    // empty solver owning its variables, variables are created with newVar //
+    CDCLSolver(const SolverOptions& opts = SolverOptions()) : CDCLSolver(ownedVariables, opts) {}
+
+    // solver without clauses over the given variables //
+    CDCLSolver(std::vector<Variable>& vars, const SolverOptions& opts = SolverOptions());
+
+    // proofWriter, if given, already receives the clauses simplified while loading //
+    CDCLSolver(const ClauseVector& clauseVector, std::vector<Variable>& vars, const SolverOptions& opts = SolverOptions(),
+               ProofWriter* proofWriter = nullptr);
+
+    // start over on another formula, the variables are replaced by vars. Every buffer keeps //
+    // its memory, so one solver can serve many small formulas without allocating again     //
+    void load(const ClauseVector& clauseVector, const std::vector<Variable>& vars);
+
+    std::vector<Variable>& getVariables() {
+      return variables;
+    }
+
+    // add a variable, returns its index. Literals of it are mkLit(index, sign) //
+    int newVar(const std::string& name) {
+      variables.emplace_back(name);
+      growVariables();
+      return variables.size() - 1;
+    }
+
+    int numVars() {
+      return variables.size();
+    }
+
+    // add a clause at decision level 0: duplicate literals and literals false at level 0 //
+    // are dropped, satisfied clauses and tautologies are skipped and unit clauses are     //
+    // assigned right away. May be called between two solve() calls. Returns false once   //
+    // the formula is unsatisfiable                                                        //
+    bool addClause(const std::vector<int>& input);
+
+    // add the constraint that at most bound of the literals are true, at decision level 0 like //
+    // addClause. It is kept whole rather than expanded into clauses; literals fixed at level 0 //
+    // are taken out, and bounds of 0 or one below the size become units or a single clause.   //
+    // A literal given twice counts twice. Returns false once the formula is unsatisfiable     //
+    bool addAtMost(const std::vector<int>& input, int bound);
+
+    // at least bound of the literals are true: at most size - bound of their negations //
+    bool addAtLeast(const std::vector<int>& input, int bound) {
+      std::vector<int> negated;
+      for (int lit : input) {
+        negated.push_back(litNeg(lit));
+      }
+      return addAtMost(negated, input.size() - bound);
+    }
+
+    bool solve(){
+      return solve(std::vector<int>());
+    }
+
+    // solve under the given assumption literals. Learnt clauses are kept for the next //
+    // call; when the answer is unsatisfiable getFailedAssumptions() tells which        //
+    // assumptions were responsible                                                      //
+    bool solve(const std::vector<int>& assumps){
+      if (solveLimited(assumps) != 1) {
+        return false;
+      }
+      storeModel();
+      return true;
+    }
+
+    // 1 satisfiable, -1 unsatisfiable, 0 when stopped through the stop flag //
+    int solveLimited(const std::vector<int>& assumps = std::vector<int>());
+
+    // value of a literal in the last model //
+    bool modelValue(int lit) {
+      return model[litVar(lit)] != litSign(lit);
+    }
+
+    // the assumptions of the last solve() that are unsatisfiable together with the //
+    // formula, empty when the formula is unsatisfiable without any assumption     //
+    const std::vector<int>& getFailedAssumptions() {
+      return conflict;
+    }
+
+    // false once the formula is unsatisfiable under every assumption //
+    bool okay() {
+      return ok;
+    }
+
+    // log every learnt and deleted clause to proof, set before the first clause is added. //
+    // Cardinality constraints cannot be expressed in the proof                            //
+    void setProof(ProofWriter* proofWriter) {
+      proof = proofWriter;
+    }
+
+    // let the next solveLimited() calls give up after this many more conflicts, -1 for no limit //
+    void setConflictBudget(long long conflicts) {
+      conflictLimit = conflicts < 0 ? -1 : stats.conflicts + conflicts;
+    }
+
+    // value of a variable under the current assignment: 1 true, -1 false, 0 unassigned //
+    int varValue(int var) {
+      return assigns[var];
+    }
+
+    // lookahead: decide and propagate the cube literals, one level each. Returns false when //
+    // that runs into a conflict. The solver stays at the cube until the next solve()          //
+    bool assumeCube(const std::vector<int>& cube);
+
+    // number of literals assigned by propagating lit on top of the current assignment, //
+    // -1 when that runs into a conflict. The assignment is undone afterwards            //
+    int lookahead(int lit);
+
+    // copy the last model into the variables //
+    void storeModel() {
+      for (size_t v = 0; v < variables.size(); ++v) {
+        variables[v].setAssignment(model[v]);
+      }
+    }
+
+    // portfolio mode: short learnt clauses are pushed to ownRing, clauses of the other //
+    // solvers are read from their rings at level 0, and search stops once stop is set  //
+    void setSharing(ClauseRing* ownRing, const std::vector<ClauseRing*>& otherRings, const std::atomic<bool>* stop) {
+      exportRing = ownRing;
+      importRings = otherRings;
+      importCursors.assign(otherRings.size(), 0);
+      stopFlag = stop;
+    }
+
+    SolverStatistics& getStatistics() {
+      return stats;
+    }
+
+    // end of run summary, printed at every verbosity //
+    void printStatistics();
+
+    void printAssignement();
+  private:
+    // main CDCL loop: propagate -> analyze -> backjump -> decide, until SAT or UNSAT is proven. //
+    // Returns 1 for SAT, -1 for UNSAT and 0 when stopped                                     //
+    int search();
+
+    // first UIP conflict analysis: resolve the conflicting clause with the reasons of the   //
+    // current level literals, walking the trail backwards, until a single literal of the    //
+    // current level is left. learnt[0] is the asserting literal, learnt[1] the literal with //
+    // the highest level among the rest. Returns the backjump level                          //
+    int analyze(CRef conflictClause, std::vector<int>& learnt);
+
+    // p is true and its negation is an assumption: collect the assumptions on the trail //
+    // that imply p, together with the failed assumption itself, into conflict          //
+    void analyzeFinal(int p);
+
+    // local search burst at level 0 on the original clauses, starting from the saved phases. //
+    // Its best assignment becomes the saved phases of the unassigned variables, so a model  //
+    // found by the local search is completed by the next descent without a conflict        //
+    void walk();
+
+    // Luby: restart after luby(restarts) * lubyUnit conflicts. Glucose: restart when the //
+    // average LBD of the recent learnt clauses is high compared to the global average     //
+    bool restartDue();
+
+    // literal block distance: number of distinct decision levels among the literals //
+    unsigned int computeLbd(const int* lits, int size);
+
+    // bit set of decision levels, used to cut the redundancy check early //
+    unsigned int abstractLevel(int var) {
+      return 1u << (level[var] & 31);
+    }
+
+    // checks whether lit is implied by the literals already marked as seen //
+    bool litRedundant(int lit, unsigned int abstractLevels);
+
+    // undo all assignments above the given decision level //
+    void cancelUntil(int backjumpLevel);
+
+    // size the per variable state for variables added since the last call //
+    void growVariables();
+
+    void loadClauses(const ClauseVector& clauseVector);
+
+    // value of a literal under the current assignment: 1 true, -1 false, 0 unassigned //
+    int litValue(int lit) {
+      int value = assigns[litVar(lit)];
+      return litSign(lit) ? -value : value;
+    }
+
+    std::string litName(int lit) {
+      return variables[litVar(lit)].getVariable() + (litSign(lit) ? "bar" : "");
+    }
+
+    int decisionLevel() {
+      return trailLim.size();
+    }
+
+    // assign a literal at the current decision level and put it on the trail, //
+    // it is propagated later by propagate()                                    //
+    void enqueue(int lit, CRef reasonClause) {
+      int var = litVar(lit);
+      assigns[var] = litSign(lit) ? -1 : 1;
+      level[var] = decisionLevel();
+      reason[var] = reasonClause;
+      trail.push_back(lit);
+    }
+
+    // literals of the reason of the implied literal p, p first //
+    const int* reasonLiterals(int p, int& size) {
+      CRef ref = reason[litVar(p)];
+      if (isBinaryReason(ref)) {
+        reasonBinary[0] = p;
+        reasonBinary[1] = binaryReasonLit(ref);
+        size = 2;
+        return reasonBinary;
+      }
+      if (isCardReason(ref)) {
+        return explainCard(p, cardReasonIndex(ref), size);
+      }
+      Clause clause = arena[ref];
+      size = clause.size();
+      return clause.literals();
+    }
+
+    // the clause a cardinality constraint stands for at this point: the implied literal p //
+    // first, or nothing for a conflict, then the negations of the true literals. They were //
+    // all assigned before p, since reaching the bound assigns every other literal at once  //
+    const int* explainCard(int p, int index, int& size);
+
+    // count the true literal p in its cardinality constraints and make the unassigned //
+    // literals false where the bound is reached. Returns the conflicting constraint as //
+    // cardReason(), or CREF_UNDEF                                                     //
+    CRef propagateCards(int p);
+
+    // watch the first two literals of a clause //
+    void attachClause(CRef ref);
+
+    void addBinary(int a, int b) {
+      implications[litNeg(a)].push_back(b);
+      implications[litNeg(b)].push_back(a);
+      binaryClauses++;
+    }
+
+    // drop a + b from the implication lists, one copy if it is there more than once //
+    void removeBinary(int a, int b);
+
+    // drop the binary clause pbar + implications[p][index] by its position in that list //
+    void removeBinaryAt(int p, size_t index);
+
+    // add a learnt clause whose first literal is asserting at the current level //
+    // and whose second literal has the highest level among the rest            //
+    void addLearntClause(const std::vector<int>& learnt);
+
+    // add the clauses learnt by the other portfolio solvers, at level 0. Returns false //
+    // when one of them is falsified, which proves the formula unsatisfiable             //
+    bool importClauses();
+
+    // propagate every trail entry not yet propagated: the binary clauses of all new literals //
+    // go first, straight from the implication lists; then the cardinality constraints of    //
+    // one literal and the long clauses watching its negation are visited. Returns the       //
+    // conflicting clause, binaryReason(q) for a binary one, cardReason() for a cardinality  //
+    // constraint, or CREF_UNDEF if no conflict occurred                                      //
+    CRef propagate();
+
+    bool clauseSatisfied(Clause clause);
+
+    // free the clauses satisfied at level 0 //
+    void removeSatisfied(std::vector<CRef>& refs);
+
+    // drop the binary clauses of the literals assigned at level 0 since the last simplify() //
+    void removeSatisfiedBinaries();
+
+    // equivalent-literal substitution and transitive reduction on the binary implication graph //
+    void simplifyBinaries();
+
+    // literals on a cycle of binary implications are equivalent: each strongly connected //
+    // component is replaced by its smallest literal in every clause, and the others are   //
+    // tied to it by two binaries so they still get their values by propagation. Returns   //
+    // false when it found new units or a contradiction, which must be propagated first    //
+    bool substituteEquivalences();
+
+    // remove the binaries a + b for which another path from abar to b exists, within a //
+    // budget of visited implications                                                  //
+    void reduceTransitive();
+
+    void freeClause(CRef ref);
+
+    // a clause is locked while it is the reason of its first literal //
+    bool locked(CRef ref);
+
+    // learnt clause database reduction: glue clauses (LBD <= 2) are kept for good, the //
+    // middle tier (LBD <= coreLbd) only while it was used since the last reduction,   //
+    // otherwise it joins the local clauses. The worse half of those is deleted,       //
+    // ordered by LBD and then by activity. Clauses that are reasons are never deleted //
+    void reduceDB();
+
+    void claBumpActivity(Clause clause);
+
+    void claDecayActivity() {
+      claInc /= 0.999;
+    }
+
+    // called at level 0 when new units were found since the last call or the binary //
+    // clauses grew enough for another substitution and transitive reduction pass    //
+    void simplify();
+
+    void checkGarbage();
+
+    // compact the arena: live clauses are copied into a fresh arena and every //
+    // reference (watchers, reasons, clause lists) is rewritten to the new offsets //
+    void garbageCollect();
+
+    void varBumpActivity(int var);
+
+    // decaying every activity is the same as growing the bump amount //
+    void varDecayActivity() {
+      varInc /= options.varDecay;
+    }
+
+    // most active unassigned variable with its preferred polarity, -1 if all are assigned //
+    int pickBranchLiteral();
+
+    void printVariables();
+
+    void printProgress();
+
+    void printLearntClause(const std::vector<int>& learnt);
+
+    void printDecisionTrail();
+};
+
+// counters of the preprocessing stage, reported apart from the search statistics //
+struct PreprocessStatistics {
+    int originalClauses;
+    int remainingClauses;       // clauses handed to the solver, units included //
+    int eliminatedVariables;
+    long long resolvents;       // clauses added by variable elimination //
+    int subsumedClauses;
+    int strengthenedClauses;    // literals removed by self-subsuming resolution //
+    int failedLiterals;         // probes that ran into a conflict //
+    int probedUnits;            // literals implied by both polarities of a probe //
+    double time;
+
+    PreprocessStatistics() : originalClauses(0), remainingClauses(0), eliminatedVariables(0), resolvents(0),
+                             subsumedClauses(0), strengthenedClauses(0), failedLiterals(0), probedUnits(0), time(0) {}
+
+    void print(std::ostream& out) const {
+      out << "c preprocess original_clauses=" << originalClauses << " remaining_clauses=" << remainingClauses
+          << " eliminated_variables=" << eliminatedVariables << " resolvents=" << resolvents
+          << " subsumed_clauses=" << subsumedClauses << " strengthened_clauses=" << strengthenedClauses
+          << " failed_literals=" << failedLiterals << " probed_units=" << probedUnits
+          << " preprocess_time=" << time << "\n";
+    }
+};
+
+//                                        *************** Preprocessor ********************                                               //
+// SatELite style simplification of the parsed formula before search:                                                                  //
+// 1) units are propagated and satisfied clauses removed                                                                               //
+// 2) backward subsumption and self-subsuming resolution, candidates are filtered with 64 bit variable signatures                      //
+// 3) failed literal probing: a literal whose propagation runs into a conflict is false, a literal implied by both polarities is true //
+// 4) bounded variable elimination: a variable is replaced by all resolvents of its clauses when they are not more than the clauses   //
+// the clauses of eliminated variables are kept, extendModel() uses them to give those variables a value afterwards                   //
+// cardinality constraints are passed on unchanged and their variables are never eliminated                                           //
+class Preprocessor {
+  private:
+    struct Entry {
+      std::vector<int> lits;     // sorted //
+      uint64_t signature;
+      bool deleted;
+    };
+    static const int RESOLVENT_LIMIT = 20;          // longest resolvent an elimination may add //
+    static const long long SUBSUME_BUDGET = 50000000; // literal comparisons spent on subsumption //
+    static const long long PROBE_BUDGET = 20000000;   // clause visits spent on probing //
+
+    SolverOptions options;
+    bool ok;
+    std::vector<Entry> clauses;
+    std::vector<std::vector<int>> occurs;   // occurs[lit]: clauses containing lit, may hold deleted clauses //
+    std::vector<int> numOccurs;             // numOccurs[lit]: live clauses containing lit //
+    std::vector<int> values;                // per variable: 1 true, -1 false, 0 unassigned //
+    std::vector<int> units;                 // assigned literals, propagated up to unitsHead //
+    size_t unitsHead;
+    std::vector<char> eliminated;
+    std::vector<char> frozen;               // variables of cardinality constraints, not eliminated //
+    std::vector<std::vector<int>> elimClauses; // clauses of eliminated variables, the pivot literal first //
+    std::vector<int> subsumeQueue;
+    std::vector<char> queued;
+    long long subsumeSteps;
+    std::vector<int> probeValues;           // per variable assignment of the current probe //
+    std::vector<int> probeTrail;
+    long long probeSteps;
+    std::vector<int> addBuffer;
+    ProofWriter* proof;                     // DRAT output of every derived and removed clause, or nullptr //
+    PreprocessStatistics stats;
+  public:
+    Preprocessor(const SolverOptions& opts = SolverOptions())
+        : options(opts), ok(true), unitsHead(0), subsumeSteps(0), probeSteps(0), proof(nullptr) {}
+
+    void setProof(ProofWriter* proofWriter) {
+      proof = proofWriter;
+    }
+
+    // forget the last formula but keep the memory, for preprocessing the next one //
+    void clear() {
+      ok = true;
+      clauses.clear();
+      units.clear();
+      unitsHead = 0;
+      elimClauses.clear();
+      subsumeQueue.clear();
+      queued.clear();
+      subsumeSteps = 0;
+      probeTrail.clear();
+      probeSteps = 0;
+      stats = PreprocessStatistics();
+    }
+
+    // simplify input into output, which has no variable names. Returns false when the //
+    // formula is unsatisfiable, output then holds the empty clause                    //
+    bool run(const ClauseVector& input, int numVars, ClauseVector& output);
+
+    // give the eliminated variables values that satisfy their removed clauses, //
+    // vars holds the model of the simplified formula                           //
+    void extendModel(std::vector<Variable>& vars);
+
+    const PreprocessStatistics& getStatistics() {
+      return stats;
+    }
+  private:
+    int litValue(int lit) {
+      int value = values[litVar(lit)];
+      return litSign(lit) ? -value : value;
+    }
+
+    // the set bits of a signature stand for the variables of a clause //
+    static uint64_t signature(const std::vector<int>& lits) {
+      uint64_t sig = 0;
+      for (int lit : lits) {
+        sig |= 1ULL << (litVar(lit) & 63);
+      }
+      return sig;
+    }
+
+    // add a clause simplified against the top level values: tautologies and satisfied //
+    // clauses are dropped, units are assigned                                          //
+    void addClause(const std::vector<int>& input);
+
+    void removeClause(int c);
+
+    // drop lit from clause c //
+    void strengthen(int c, int lit);
+
+    void assignUnit(int lit);
+
+    // remove the clauses satisfied by the new units and the false literals of the others //
+    bool propagateUnits();
+
+    // occurrence list of lit without the deleted clauses //
+    std::vector<int>& cleanOccurs(int lit);
+
+    // -2 when a does not subsume b, -1 when it does, otherwise the literal of b whose //
+    // negation is in a: a then subsumes b without that literal                          //
+    int subsumes(const Entry& a, const Entry& b);
+
+    void backwardSubsume(int c);
+
+    bool subsumeAll();
+
+    // propagate lit under the top level values, the implied literals are left in  //
+    // probeTrail and probeValues. Returns false on a conflict                     //
+    bool probeLiteral(int lit);
+
+    bool probe();
+
+    // resolvent of a and b on var, false when it is a tautology //
+    bool resolve(const std::vector<int>& a, const std::vector<int>& b, int var, std::vector<int>& resolvent);
+
+    bool tryEliminate(int var);
+
+    bool eliminate();
+};
+
+// runs several differently configured solvers on the same formula in parallel, the first //
+// answer wins and stops the others. The parsed ClauseVector and the variable names are    //
+// shared read-only; every solver builds its own arena since watching reorders literals   //
+class Portfolio {
+  private:
+    const ClauseVector& clauseVector;
+    std::vector<Variable>& variables;
+    SolverOptions options;
+    std::vector<std::unique_ptr<ClauseRing>> rings;
+    std::vector<std::unique_ptr<CDCLSolver>> solvers;
+    std::atomic<bool> stop;
+    std::atomic<int> winner;
+    int result;
+
+    // worker i differs from the others in seed, restart policy and initial phases //
+    SolverOptions workerOptions(int i);
+
+    void work(int i);
+  public:
+    Portfolio(const ClauseVector& clauseVec, std::vector<Variable>& vars, const SolverOptions& opts)
+        : clauseVector(clauseVec), variables(vars), options(opts), stop(false), winner(-1), result(0) {}
+
+    // 1 satisfiable, -1 unsatisfiable //
+    int solve();
+
+    int getWinnerIndex() {
+      return winner.load();
+    }
+
+    CDCLSolver& getWinner() {
+      return *solvers[winner.load()];
+    }
+};
+
+// counters of a cube and conquer run //
+struct CubeStatistics {
+    long long initialCubes;     // cubes made by the lookahead before the workers started //
+    long long refutedCubes;     // cubes the lookahead itself proved unsatisfiable //
+    long long solvedCubes;      // cubes the workers proved unsatisfiable //
+    long long resplits;         // cubes split again after running out of conflicts //
+    long long lookaheads;       // literals propagated to score variables //
+    double lookaheadTime;
+    double conquerTime;
+
+    CubeStatistics() : initialCubes(0), refutedCubes(0), solvedCubes(0), resplits(0), lookaheads(0), lookaheadTime(0),
+                       conquerTime(0) {}
+
+    void print(std::ostream& out, int threads) const {
+      out << "c cube threads=" << threads << " initial_cubes=" << initialCubes << " refuted_cubes=" << refutedCubes
+          << " solved_cubes=" << solvedCubes << " resplits=" << resplits << " lookaheads=" << lookaheads
+          << " lookahead_time=" << lookaheadTime << " conquer_time=" << conquerTime << "\n";
+    }
+};
+
+// cube and conquer: a lookahead splits the formula into many cubes (conjunctions of //
+// literals) that together cover every assignment, and a pool of CDCL workers solves //
+// them as assumptions. Workers pull cubes from a shared queue, keep their learnt     //
+// clauses from cube to cube and share the short ones like the portfolio does. A cube //
+// still open after cubeConflicts conflicts is split again, with twice the budget for //
+// each half, so hard regions of the search space end up spread over all workers     //
+class CubeAndConquer {
+  private:
+    struct Cube {
+      std::vector<int> lits;
+      long long budget; // conflicts before the cube is split again, -1 for no limit //
+    };
+    static const int LOOKAHEAD_CANDIDATES = 64; // unassigned variables scored per split //
+
+    const ClauseVector& clauseVector;
+    std::vector<Variable>& variables;
+    SolverOptions options;
+    std::vector<int> candidates;          // variables by decreasing number of occurrences //
+    std::vector<std::unique_ptr<ClauseRing>> rings;
+    std::vector<std::unique_ptr<CDCLSolver>> solvers;
+    std::mutex lock;                      // guards queue, openCubes and the counters below //
+    std::condition_variable workAvailable;
+    std::deque<Cube> queue;
+    long long openCubes;                  // cubes queued or being solved //
+    std::atomic<bool> stop;
+    std::atomic<int> winner;
+    int result;
+    std::atomic<long long> lookaheads;
+    CubeStatistics stats;
+
+    // the variable whose two lookaheads give the largest product of implied literals. //
+    // Failed lookaheads add the opposite literal to the cube. Returns -1 when the cube //
+    // is refuted, 0 when no variable is left to split on and 1 with the branch var set //
+    int split(CDCLSolver& solver, std::vector<int>& cube, int& branchVar);
+
+    // the first answer, or unsatisfiable once every cube is closed //
+    void finish(int id, int answer);
+
+    void work(int id);
+  public:
+    CubeAndConquer(const ClauseVector& clauseVec, std::vector<Variable>& vars, const SolverOptions& opts);
+
+    // 1 satisfiable, -1 unsatisfiable //
+    int solve();
+
+    int getWinnerIndex() {
+      return winner.load();
+    }
+
+    CDCLSolver& getWinner() {
+      return *solvers[winner.load()];
+    }
+
+    const CubeStatistics& getStatistics() {
+      return stats;
+    }
+};
+
+// reads a file of several formulas piece by piece and hands out one formula text at a time. //
+// Formulas in the x1 + x3bar syntax are separated by blank lines, DIMACS formulas start at  //
+// their "p cnf" header; a % line ends a DIMACS formula as in the SATLIB benchmark files     //
+class FormulaStream {
+  private:
+    int fd;
+    std::vector<char> buffer;
+    size_t position;
+    size_t filled;
+    int format;                // 0 not known yet, 1 DIMACS, 2 x1 + x3bar lines //
+    std::string pendingHeader; // "p cnf" line read ahead, it opens the next formula //
+
+    bool readLine(std::string& line);
+  public:
+    FormulaStream() : fd(-1), buffer(1 << 16), position(0), filled(0), format(0) {}
+    ~FormulaStream();
+
+    bool open(const std::string& filename);
+
+    // text of the next formula, false at the end of the input //
+    bool next(std::string& formula);
+};
+
+// counters of a batch run //
+struct BatchStatistics {
+    long long formulas;
+    long long satisfiable;
+    long long unsatisfiable;
+    long long errors;          // formulas that failed to parse //
+    long long steals;          // formulas taken from the queue of another worker //
+    double time;
+
+    BatchStatistics() : formulas(0), satisfiable(0), unsatisfiable(0), errors(0), steals(0), time(0) {}
+
+    void print(std::ostream& out, int threads) const {
+      out << "c batch formulas=" << formulas << " satisfiable=" << satisfiable << " unsatisfiable=" << unsatisfiable
+          << " errors=" << errors << " threads=" << threads << " steals=" << steals << " time=" << time
+          << " formulas_per_sec=" << (long long)(time > 0 ? formulas / time : 0) << "\n";
+    }
+};
+
+// solves independent formulas on a pool of worker threads. The reading thread deals the       //
+// formulas out round robin to per worker queues, an idle worker steals from the others. Each //
+// worker keeps one solver and one ClauseVector and reuses them for every formula it takes.   //
+// Results are printed one line per formula, in input order:                                  //
+//   <n>: satisfiable x1 x2bar ...    or    <n>: unsatisfiable    or    <n>: parse error       //
+class BatchSolver {
+  private:
+    struct Task {
+      long long index;
+      std::string text;
+    };
+    struct WorkerQueue {
+      std::mutex lock;
+      std::deque<Task> tasks;
+    };
+    SolverOptions options;
+    int numThreads;
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::mutex taskLock;                  // guards queuedTasks changes against sleeping workers //
+    std::condition_variable taskAvailable;
+    std::atomic<long long> queuedTasks;
+    bool inputDone;
+    std::mutex resultLock;
+    std::condition_variable resultReady;
+    std::map<long long, std::string> results; // finished lines not printed yet //
+    std::atomic<long long> satisfiable;
+    std::atomic<long long> unsatisfiable;
+    std::atomic<long long> errors;
+    std::atomic<long long> steals;
+    BatchStatistics stats;
+
+    // oldest formula of the own queue, else of another queue; false once all work is done //
+    bool takeTask(int id, Task& task);
+
+    // the formula, the preprocessor and the solver belong to the worker and keep their memory across tasks //
+    void solveTask(const Task& task, ClauseVector& formula, Preprocessor& preprocessor, ClauseVector& simplified,
+                   CDCLSolver& solver, std::string& line);
+
+    void work(int id);
+
+    // print the finished lines that are next in input order, waiting for the first one if asked to //
+    void printReady(long long& nextIndex, bool wait, std::ostream& out);
+  public:
+    BatchSolver(const SolverOptions& opts);
+
+    void run(FormulaStream& input, std::ostream& out);
+
+    const BatchStatistics& getStatistics() {
+      return stats;
+    }
+};
+
+// counters of a server run, shared by all connections //
+struct ServerStatistics {
+    long long requests;
+    long long satisfiable;
+    long long unsatisfiable;
+    long long errors;              // malformed requests and formulas that failed to parse //
+    std::vector<double> latencies; // per request, from its header to the end of its response //
+
+    ServerStatistics() : requests(0), satisfiable(0), unsatisfiable(0), errors(0) {}
+
+    // one key=value line with the p50 and p99 latencies in milliseconds //
+    void print(std::ostream& out) const;
+};
+
+// long running solver answering framed requests, on stdin and stdout or on the connections of a //
+// Unix domain socket. A request and a response are both a header line "<kind> <length>" and    //
+// length bytes of payload. Requests:                                                            //
+//   f <n>  solve the formula in the payload, DIMACS or x1 + x3bar lines                          //
+//   a <n>  add clauses to the incremental formula, DIMACS literals with a 0 after each clause   //
+//   q <n>  solve the incremental formula under the DIMACS literals of the payload             //
+//   r 0    start a new, empty incremental formula                                             //
+//   t 0    statistics of the server so far                                                    //
+//   x 0    stop the server                                                                    //
+// Responses: "s <n>" with the model as DIMACS literals ending in 0, "u <n>" with the failed  //
+// assumptions of a q request ending in 0, "o 0" for a, r and x, "t <n>" with the statistics   //
+// line and "e <n>" with an error message. x1 + x3bar variables are numbered in order of first //
+// appearance. Each worker keeps its solvers between requests, so their memory stays allocated //
+class SolverServer {
+  private:
+    struct Connection {
+      int fd;
+      int outFd;
+      std::vector<char> buffer;
+      size_t position;
+      size_t filled;
+
+      Connection(int in, int out) : fd(in), outFd(out), buffer(1 << 16), position(0), filled(0) {}
+    };
+    // state of one worker, reused for every request it answers //
+    struct Session {
+      ClauseVector formula;
+      Preprocessor preprocessor; // f requests, cleared for each formula //
+      ClauseVector simplified;
+      CDCLSolver solver;      // f requests, loaded with each formula //
+      CDCLSolver incremental; // a and q requests //
+      std::vector<int> lits;
+      std::string response;
+
+      Session(const SolverOptions& opts) : preprocessor(opts), solver(opts), incremental(opts) {}
+    };
+    SolverOptions options;
+    int listenFd;
+    std::atomic<bool> stopping;
+    std::mutex statsLock;
+    ServerStatistics stats;
+
+    bool readLine(Connection& conn, std::string& line);
+
+    bool readPayload(Connection& conn, std::string& payload, size_t size);
+
+    bool writeFrame(Connection& conn, char kind, const std::string& payload);
+
+    // DIMACS literals of a payload as packed literals, false on anything else //
+    bool parseLiterals(const std::string& payload, std::vector<int>& lits, bool clauses);
+
+    // answer one request, returns the kind of the response //
+    char answer(char kind, const std::string& payload, Session& session);
+
+    // answer the requests of a connection until it ends, false once the server is stopped //
+    bool serve(Connection& conn, Session& session);
+
+    void work();
+  public:
+    SolverServer(const SolverOptions& opts);
+
+    // requests on stdin, responses on stdout //
+    void runStdio();
+
+    // listen on path with options.threads workers, each serving one connection at a time //
+    bool runSocket(const std::string& path);
+
+    ServerStatistics getStatistics() {
+      std::lock_guard<std::mutex> guard(statsLock);
+      return stats;
+    }
+};
+
+// counters of the AIGER front-end //
+struct AigerStatistics {
+    int inputs;               // inputs and latches of the netlist //
+    int outputs;              // outputs checked, miter outputs for two netlists //
+    long long fileGates;      // AND gates of the netlists as read //
+    long long coneGates;      // gates left in the cone of influence of the outputs after hashing //
+    long long hashedGates;    // gates found already built, or constant, by structural hashing //
+    int clauses;
+    double parseTime;
+    double encodeTime;
+
+    AigerStatistics() : inputs(0), outputs(0), fileGates(0), coneGates(0), hashedGates(0), clauses(0), parseTime(0),
+                        encodeTime(0) {}
+
+    void print(std::ostream& out) const {
+      out << "c aiger inputs=" << inputs << " outputs=" << outputs << " file_gates=" << fileGates
+          << " cone_gates=" << coneGates << " hashed_gates=" << hashedGates << " clauses=" << clauses
+          << " parse_time=" << parseTime << " encode_time=" << encodeTime << "\n";
+    }
+};
+
+//                                        *************** Aiger ********************                                            //
+// and-inverter graph netlists in the AIGER format, ASCII (aag) or binary (aig), encoded into clauses for a combinational check: //
+// 1) only the gates in the cone of influence of the checked outputs are visited, depth first from the outputs                 //
+// 2) structural hashing: a gate is built once per pair of inputs, constants and x & x, x & xbar are folded away                 //
+// 3) Tseitin encoding straight into a ClauseVector, three clauses per gate, plus one clause asking for an output to be true    //
+// Latches are free inputs and invariant constraints must hold. Two netlists form a miter: inputs are matched by position and   //
+// the formula is satisfiable exactly when some pair of outputs can differ, so unsatisfiable means equivalent                  //
+class Aiger {
+  private:
+    struct Netlist {
+      unsigned maxVar;
+      unsigned latches;
+      std::vector<unsigned> inputs;      // literals of the inputs, then of the latches //
+      std::vector<unsigned> outputs;     // outputs, then bad state properties //
+      std::vector<unsigned> constraints; // invariant constraints //
+      std::vector<unsigned> gates;       // left side and both fanins of each AND gate //
+      std::vector<std::string> names;    // per input and latch, empty when the symbol table has none //
+    };
+    std::vector<Netlist> netlists;
+    // the hashed graph: node 0 is the constant false and nodes 1 .. inputs the inputs, the rest //
+    // are AND gates after their fanins. Literals are 2 * node + sign, as for the solver         //
+    std::vector<int> fanins;              // fanins[2n], fanins[2n + 1]: the inputs of node n //
+    std::unordered_map<uint64_t, int> strash;
+    int numInputs;
+    int lineNumber;
+    AigerStatistics stats;
+
+    bool parse(const char* data, size_t size, Netlist& netlist);
+
+    bool parseError(const std::string& message);
+
+    // the numbers of one line, at most 'most' of them. Returns how many there were, //
+    // -1 when the line holds anything else                                           //
+    int readNumbers(const char*& p, const char* end, unsigned* values, int most);
+
+    // a difference of the binary AND gate section: 7 bits per byte, low bits first //
+    bool readDelta(const char*& p, const char* end, unsigned& delta);
+
+    // literal of the AND of a and b, an existing node when there is one //
+    int mkAnd(int a, int b);
+
+    int mkXor(int a, int b) {
+      return litNeg(mkAnd(litNeg(mkAnd(a, litNeg(b))), litNeg(mkAnd(litNeg(a), b))));
+    }
+
+    // hashed literals of the netlist literals in roots. Gates are built depth first from //
+    // the roots, so the gates outside their cone of influence are never touched          //
+    bool build(const Netlist& netlist, const std::vector<unsigned>& roots, std::vector<int>& hashed);
+  public:
+    Aiger() : fanins(2, 0), numInputs(0), lineNumber(1) {}
+
+    // true when the file starts with an AIGER header //
+    static bool detect(const std::string& filename);
+
+    // read a netlist, the second one read is the other side of a miter //
+    bool readFromFile(const std::string& filename);
+
+    // encode the given outputs, all of them when empty, into formula. Its first variables //
+    // are the inputs and latches, named by the symbol table or i<n> and l<n>             //
+    bool encode(const std::vector<int>& outputs, ClauseVector& formula);
+
+    int getNumInputs() {
+      return numInputs;
+    }
+
+    const AigerStatistics& getStatistics() {
+      return stats;
+    }
+};
+
+#endif
@@ -0,0 +1,86 @@
+# helpers shared by the regression tests: random formulas, brute force, running the solver
+import atexit
+import itertools
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+SOLVER = os.path.abspath(sys.argv[1]) if len(sys.argv) > 1 else os.path.join(os.path.dirname(__file__), '..', 'cdcl')
+WORKDIR = tempfile.mkdtemp(prefix='cdcl_tests_')
+atexit.register(shutil.rmtree, WORKDIR, True)
+
+
+def path(name):
+    return os.path.join(WORKDIR, name)
+
+
+def random_cnf(rng, n, m, k=3):
+    return [[v * rng.choice((1, -1)) for v in rng.sample(range(1, n + 1), min(k, n))] for _ in range(m)]
+
+
+def dimacs(n, clauses):
+    return 'p cnf %d %d\n' % (n, len(clauses)) + ''.join(' '.join(map(str, c)) + ' 0\n' for c in clauses)
+
+
+def line_syntax(clauses):
+    return ''.join(' + '.join('x%d%s' % (abs(l), 'bar' if l < 0 else '') for l in c) + '\n' for c in clauses)
+
+
+def satisfies(model, clauses, assumptions=()):
+    value = lambda l: model.get(abs(l), False) == (l > 0)
+    return all(value(a) for a in assumptions) and all(any(value(l) for l in c) for c in clauses)
+
+
+def brute_force(n, clauses, assumptions=()):
+    for bits in itertools.product((False, True), repeat=n):
+        model = {v + 1: bits[v] for v in range(n)}
+        if satisfies(model, clauses, assumptions):
+            return True
+    return False
+
+
+def run(args, text=None, name='input.cnf', timeout=120):
+    """run the solver on text (written to a file appended to args), returns (stdout, stderr, exit code)"""
+    if text is not None:
+        with open(path(name), 'w') as f:
+            f.write(text)
+        args = args + [path(name)]
+    r = subprocess.run([SOLVER] + args, capture_output=True, text=True, timeout=timeout)
+    return r.stdout, r.stderr, r.returncode
+
+
+def answer(out):
+    """None for unsatisfiable, otherwise the model {variable: value} of an x<k> named assignment"""
+    if 'Formula is unsatisfiable.' in out:
+        return None
+    if 'Satisfying assignment:' not in out:
+        raise AssertionError('no answer in the output:\n' + out[-500:])
+    model = {}
+    for line in out.splitlines():
+        match = re.match(r'^x(\d+): (true|false)$', line)
+        if match:
+            model[int(match.group(1))] = match.group(2) == 'true'
+    return model
+
+
+class Failures:
+    """counts failed checks and prints the first few, the test exits with the count"""
+    def __init__(self, name):
+        self.name = name
+        self.count = 0
+        self.checks = 0
+
+    def check(self, condition, message):
+        self.checks += 1
+        if not condition:
+            self.count += 1
+            if self.count <= 10:
+                print('FAIL %s: %s' % (self.name, message))
+        return condition
+
+    def finish(self):
+        print('%s: %d checks, %d failed' % (self.name, self.checks, self.count))
+        sys.exit(1 if self.count else 0)
@@ -0,0 +1,80 @@
+# forward RUP checker for the binary DRAT proofs written with --proof, small formulas only
+from collections import Counter
+
+
+def decode(data):
+    """[(kind, literals)] of a binary DRAT proof, kind is 'a' or 'd'"""
+    steps = []
+    i = 0
+    while i < len(data):
+        kind = chr(data[i])
+        if kind not in 'ad':
+            raise ValueError('bad proof step kind at byte %d' % i)
+        i += 1
+        lits = []
+        while True:
+            u = shift = 0
+            while True:
+                if i == len(data):
+                    raise ValueError('truncated proof')
+                b = data[i]
+                i += 1
+                u |= (b & 127) << shift
+                shift += 7
+                if b < 128:
+                    break
+            if u == 0:
+                break
+            lits.append((u >> 1) * (-1 if u & 1 else 1))
+        steps.append((kind, lits))
+    return steps
+
+
+def implied(db, clause):
+    """true when unit propagation on db and the negation of clause reaches a conflict"""
+    value = {}
+    for l in clause:
+        value[-l] = True
+        value[l] = False
+    changed = True
+    while changed:
+        changed = False
+        for c in db:
+            unknown = None
+            free = 0
+            satisfied = False
+            for l in c:
+                v = value.get(l)
+                if v is True:
+                    satisfied = True
+                    break
+                if v is None:
+                    free += 1
+                    unknown = l
+                    if free > 1:
+                        break
+            if satisfied or free > 1:
+                continue
+            if free == 0:
+                return True
+            value[unknown] = True
+            value[-unknown] = False
+            changed = True
+    return False
+
+
+def check(clauses, data):
+    """'ok' when every added lemma is RUP and the empty clause is derived, otherwise the reason"""
+    db = Counter(tuple(sorted(c)) for c in clauses)
+    for n, (kind, lits) in enumerate(decode(data)):
+        key = tuple(sorted(lits))
+        if kind == 'd':
+            if db[key] > 0:
+                db[key] -= 1
+            continue
+        if not implied([c for c, m in db.items() if m > 0], lits):
+            return 'lemma %d %s is not RUP' % (n, lits)
+        db[key] += 1
+        if not lits:
+            return 'ok'
+    return 'no empty clause'
@@ -0,0 +1,16 @@
+#!/bin/sh
+# runs every regression test against the solver binary, ./tests/run_tests.sh [path to cdcl]
+# each test checks the answers against brute force or an independent checker
+dir=$(dirname "$0")
+solver=${1:-$dir/../cdcl}
+failed=0
+for test in "$dir"/test_*.py; do
+    if ! python3 "$test" "$solver"; then
+        failed=$((failed + 1))
+    fi
+done
+if [ "$failed" -ne 0 ]; then
+    echo "$failed test(s) failed"
+    exit 1
+fi
+echo "all tests passed"
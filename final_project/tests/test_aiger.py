@@ -0,0 +1,206 @@
+# AIGER netlists in the ASCII and binary format: random netlists checked by simulation, output
+# selection, miters of equivalent and of different circuits, and malformed files
+import itertools
+import random
+
+from cnfutil import *
+
+failures = Failures('aiger')
+
+
+class Netlist:
+    """an and-inverter graph written in either AIGER format, literal 0 is false and 1 true"""
+    def __init__(self, inputs, latches=0):
+        self.inputs = inputs
+        self.latches = latches
+        self.gates = []  # (lhs, rhs0, rhs1) in creation order
+        self.outputs = []
+        self.bad = []
+        self.constraints = []
+        self.names = {}
+        self.next = inputs + latches + 1
+
+    def input(self, k):
+        return 2 * (k + 1)
+
+    def AND(self, a, b):
+        lhs = 2 * self.next
+        self.next += 1
+        self.gates.append((lhs, a, b))
+        return lhs
+
+    def OR(self, a, b):
+        return self.AND(a ^ 1, b ^ 1) ^ 1
+
+    def XOR(self, a, b):
+        return self.OR(self.AND(a, b ^ 1), self.AND(a ^ 1, b))
+
+    def header(self, format):
+        counts = [self.next - 1, self.inputs, self.latches, len(self.outputs), len(self.gates)]
+        if self.bad or self.constraints:
+            counts += [len(self.bad), len(self.constraints)]
+        return ' '.join([format] + [str(c) for c in counts]) + '\n'
+
+    def symbols(self):
+        return ''.join('i%d %s\n' % (k, name) for k, name in self.names.items()) + 'c\nwritten by the test\n'
+
+    def ascii(self, rng):
+        gates = list(self.gates)
+        rng.shuffle(gates)  # the ASCII format does not need the gates in order
+        text = self.header('aag') + ''.join('%d\n' % self.input(k) for k in range(self.inputs))
+        text += ''.join('%d %d\n' % (self.input(self.inputs + k), rng.randrange(2 * self.next)) for k in range(self.latches))
+        text += ''.join('%d\n' % o for o in self.outputs + self.bad + self.constraints)
+        text += ''.join('%d %d %d\n' % g for g in gates)
+        return (text + self.symbols()).encode()
+
+    def binary(self, rng):
+        text = self.header('aig') + ''.join('%d\n' % rng.randrange(2 * self.next) for k in range(self.latches))
+        text += ''.join('%d\n' % o for o in self.outputs + self.bad + self.constraints)
+        data = bytearray(text.encode())
+        for lhs, a, b in self.gates:
+            rhs0, rhs1 = max(a, b), min(a, b)
+            for delta in (lhs - rhs0, rhs0 - rhs1):
+                while delta >= 0x80:
+                    data.append(delta & 0x7f | 0x80)
+                    delta >>= 7
+                data.append(delta)
+        return bytes(data) + self.symbols().encode()
+
+    def simulate(self, values):
+        """values of the outputs (bad states included) and of the constraints"""
+        signal = {0: False}
+        for k in range(self.inputs + self.latches):
+            signal[k + 1] = values[k]
+        literal = lambda l: signal[l >> 1] != bool(l & 1)
+        for lhs, a, b in self.gates:
+            signal[lhs >> 1] = literal(a) and literal(b)
+        return [literal(o) for o in self.outputs + self.bad], [literal(c) for c in self.constraints]
+
+
+def solve(args, data, name='netlist.aig'):
+    with open(path(name), 'wb') as f:
+        f.write(data)
+    return run(['-q'] + args + [path(name)])
+
+
+def assignment(out, header):
+    """{name: value} printed after the header line"""
+    values = {}
+    for line in out.split(header + '\n')[1].splitlines():
+        name, value = line.split(': ')
+        values[name] = value == 'true'
+    return values
+
+
+rng = random.Random(13)
+for it in range(300):
+    inputs, latches = rng.randint(1, 7), rng.randint(0, 3)
+    netlist = Netlist(inputs, latches)
+    pool = [netlist.input(k) for k in range(inputs + latches)] + [0, 1]
+    for _ in range(rng.randint(0, 40)):
+        a = rng.choice(pool[-20:] if rng.random() < 0.6 else pool) ^ rng.randint(0, 1)
+        pool.append(netlist.AND(a, rng.choice(pool) ^ rng.randint(0, 1)))
+    netlist.outputs = [rng.choice(pool[-10:]) ^ rng.randint(0, 1) for _ in range(rng.randint(1, 4))]
+    if rng.random() < 0.3:
+        netlist.bad.append(rng.choice(pool) ^ rng.randint(0, 1))
+    if rng.random() < 0.3:
+        netlist.constraints.append(rng.choice(pool) ^ rng.randint(0, 1))
+    for k in range(inputs):
+        if rng.random() < 0.5:
+            netlist.names[k] = 'in_%d' % k
+    checked = list(range(len(netlist.outputs) + len(netlist.bad)))
+    args = []
+    if rng.random() < 0.5:
+        checked = sorted(rng.sample(checked, rng.randint(1, len(checked))))
+        args = sum([['--output', str(o)] for o in checked], [])
+    data = netlist.ascii(rng) if it % 2 == 0 else netlist.binary(rng)
+    out, err, code = solve(args, data)
+
+    def fires(values):
+        outputs, constraints = netlist.simulate(values)
+        return all(constraints) and any(outputs[o] for o in checked)
+    expect = any(fires(values) for values in itertools.product((False, True), repeat=inputs + latches))
+    if 'Satisfying assignment:' not in out:
+        failures.check('Formula is unsatisfiable.' in out and not expect, 'netlist %d: %s %s' % (it, out[-200:], err))
+        continue
+    names = [netlist.names.get(k, 'i%d' % k) for k in range(inputs)] + ['l%d' % k for k in range(latches)]
+    values = assignment(out, 'Satisfying assignment:')
+    if failures.check(sorted(values) == sorted(names), 'netlist %d: printed %s, inputs %s' % (it, sorted(values), names)):
+        failures.check(fires([values[name] for name in names]), 'netlist %d: assignment fires no checked output' % it)
+
+
+def adder(bits, mutate=False, lookahead=False):
+    """ripple carry adder of two bits-wide numbers, or with carry lookahead in blocks of four"""
+    netlist = Netlist(2 * bits)
+    x = [netlist.input(k) for k in range(bits)]
+    y = [netlist.input(bits + k) for k in range(bits)]
+    generate = [netlist.AND(a, b) for a, b in zip(x, y)]
+    propagate = [netlist.XOR(a, b) for a, b in zip(x, y)]
+    carry = [0]
+    for k in range(bits):
+        if lookahead and k % 4 == 3:
+            # c[k+1] = g[k] | p[k] g[k-1] | p[k] p[k-1] g[k-2] | ... | p[k..k-3] c[k-3]
+            term, chain = generate[k], propagate[k]
+            for j in range(k - 1, k - 4, -1):
+                term = netlist.OR(term, netlist.AND(chain, generate[j]))
+                chain = netlist.AND(chain, propagate[j])
+            carry.append(netlist.OR(term, netlist.AND(chain, carry[k - 3])))
+        else:
+            carry.append(netlist.OR(generate[k], netlist.AND(propagate[k], carry[k])))
+    netlist.outputs = [netlist.XOR(propagate[k], carry[k]) for k in range(bits)] + [carry[bits]]
+    if mutate:
+        netlist.outputs[bits // 2] = netlist.OR(propagate[bits // 2], carry[bits // 2])
+    return netlist
+
+
+def multiplier(bits, swap):
+    netlist = Netlist(2 * bits)
+    x = [netlist.input(k) for k in range(bits)]
+    y = [netlist.input(bits + k) for k in range(bits)]
+    if swap:
+        x, y = y, x
+    total = [0] * (2 * bits)
+    for i in range(bits):
+        carry = 0
+        for j in range(bits):
+            partial, sum = netlist.AND(x[j], y[i]), total[i + j]
+            half = netlist.XOR(sum, partial)
+            total[i + j] = netlist.XOR(half, carry)
+            carry = netlist.OR(netlist.AND(sum, partial), netlist.AND(half, carry))
+        total[i + bits] = carry
+    netlist.outputs = total
+    return netlist
+
+
+def miter(a, b):
+    with open(path('other.aig'), 'wb') as f:
+        f.write(b.binary(rng))
+    return solve(['--miter', path('other.aig')], a.ascii(rng))
+
+
+out, err, code = miter(adder(12), adder(12, lookahead=True))
+failures.check('Netlists are equivalent.' in out, 'adder miter: ' + out[-200:] + err)
+out, err, code = miter(multiplier(4, False), multiplier(4, True))
+failures.check('Netlists are equivalent.' in out, 'multiplier miter: ' + out[-200:] + err)
+good, bad = adder(12), adder(12, mutate=True)
+out, err, code = miter(good, bad)
+if failures.check('Netlists differ on the inputs:' in out, 'mutated adder miter: ' + out[-200:] + err):
+    values = assignment(out, 'Netlists differ on the inputs:')
+    inputs = [values['i%d' % k] for k in range(24)]
+    failures.check(good.simulate(inputs)[0] != bad.simulate(inputs)[0], 'mutated adder miter: inputs do not tell them apart')
+
+# malformed files are reported with the line they fail on
+errors = [('aag 3 2 0 1 1 0 0 1 0\n2\n4\n6\n6 2 4\n', 'line 1: justice and fairness properties are not supported'),
+          ('aag 3 2 0 1\n', 'line 1: AIGER header'),
+          ('aag 3 2 0 1 1\n2\n4\n8\n6 2 4\n', 'line 4: output literal expected'),
+          ('aag 3 2 0 1 1\n2\n2\n6\n6 2 4\n', 'line 3: bad or repeated input literal'),
+          ('aag 1 1 0 1 0\n2\n', 'line 3: output literal expected'),
+          ('aag 3 2 0 1 1\n2\n4\n6\n6 2\n', 'line 5: AND gate expected'),
+          ('aag 3 2 0 1 1\n2\n4\n6\n6 2 4\nx1 a\n', 'line 6: symbol table entry expected'),
+          ('aag 4 1 0 1 2\n2\n6\n6 2 8\n8 6 2\n', 'combinational cycle')]
+for text, message in errors:
+    out, err, code = solve([], text.encode(), 'bad.aag')
+    failures.check(code == 1 and message in err, 'malformed %r: %s' % (text, err.strip()))
+out, err, code = solve(['--output', '3'], b'aag 3 2 0 1 1\n2\n4\n6\n6 2 4\n')
+failures.check(code == 1 and 'Output 3 does not exist' in err, 'missing output: ' + err.strip())
+failures.finish()
@@ -0,0 +1,58 @@
+# random formulas in every solving mode, answers checked against brute force
+import random
+
+from cnfutil import *
+
+failures = Failures('brute')
+rng = random.Random(23)
+modes = [[], ['--no-preprocess'], ['--restart', 'luby', '--luby-unit', '5'], ['--restart', 'none'],
+         ['--reduce-first', '5', '--reduce-inc', '1'], ['--phase', 'random', '--random-freq', '0.2'],
+         ['--no-walk'], ['--walk', 'walksat'], ['--threads', '3'], ['--cube', '--threads', '2'],
+         ['--elim-occurrences', '2']]
+
+
+def implication_heavy(rng, n):
+    """binary chains with duplicates and transitive shortcuts, for equivalences and transitive reduction"""
+    clauses = []
+    order = list(range(1, n + 1))
+    rng.shuffle(order)
+    for a, b in zip(order, order[1:]):
+        clauses.append([-a * rng.choice((1, -1)), b])
+    for _ in range(rng.randint(0, n)):
+        a, b = rng.sample(range(1, n + 1), 2)
+        clauses.append([a * rng.choice((1, -1)), b * rng.choice((1, -1))])
+    clauses += [list(c) for c in rng.sample(clauses, rng.randint(0, len(clauses) // 2))]
+    clauses += random_cnf(rng, n, rng.randint(0, 2 * n), 3)
+    rng.shuffle(clauses)
+    return clauses
+
+
+for it in range(600):
+    n = rng.randint(3, 14)
+    if it % 2 == 0:
+        clauses = random_cnf(rng, n, int(n * rng.uniform(2, 6)), rng.choice((2, 3, 3, 4)))
+        if rng.random() < 0.2:
+            clauses.append([rng.choice((1, -1)) * rng.randint(1, n)])
+    else:
+        clauses = implication_heavy(rng, n)
+    syntax = rng.choice(('dimacs', 'lines'))
+    expect = brute_force(n, clauses)
+    # the preprocessor removes most binaries, the solver's own binary simplification needs it off
+    for mode in [modes[it % len(modes)]] + ([['--no-preprocess']] if it % 2 == 1 else []):
+        out, err, code = run(['-q'] + mode, dimacs(n, clauses) if syntax == 'dimacs' else line_syntax(clauses))
+        model = answer(out)
+        if model is None:
+            failures.check(not expect, 'formula %d %s: wrong unsatisfiable' % (it, mode))
+        else:
+            failures.check(satisfies(model, clauses), 'formula %d %s: bad assignment' % (it, mode))
+
+# standalone local search only answers satisfiable formulas
+for it in range(60):
+    n = rng.randint(5, 14)
+    clauses = random_cnf(rng, n, int(n * 3), 3)
+    if not brute_force(n, clauses):
+        continue
+    out, err, code = run(['-q', '--local-search', '--walk-flips', '1000000'], dimacs(n, clauses))
+    if 'Satisfying assignment:' in out:
+        failures.check(satisfies(answer(out), clauses), 'local search formula %d: bad assignment' % it)
+failures.finish()
@@ -0,0 +1,73 @@
+# at-most-k and at-least-k constraints mixed with clauses, in both syntaxes and every solving
+# mode that accepts them, checked against brute force
+import itertools
+import random
+
+from cnfutil import *
+
+failures = Failures('cardinality')
+rng = random.Random(41)
+modes = [[], ['--no-preprocess'], ['--threads', '3'], ['--cube', '--threads', '2'], ['--no-walk'],
+         ['--restart', 'luby', '--luby-unit', '5'], ['--reduce-first', '5', '--reduce-inc', '1']]
+
+
+def holds(values, constraints):
+    for kind, lits, bound in constraints:
+        true = sum(1 for l in lits if values[abs(l) - 1] == (l > 0))
+        if (kind == 'clause' and true == 0) or (kind == '<=' and true > bound) or (kind == '>=' and true < bound):
+            return False
+    return True
+
+
+for it in range(420):
+    n = rng.randint(3, 10)
+    constraints = []
+    for _ in range(rng.randint(1, 12)):
+        # repeated variables and both polarities of one variable are allowed in a constraint
+        lits = [rng.randint(1, n) * rng.choice((1, -1)) for _ in range(rng.randint(1, 7))]
+        if rng.random() < 0.5:
+            constraints.append(('clause', lits[:4], 0))
+        else:
+            constraints.append((rng.choice(('<=', '>=')), lits, rng.randint(0, len(lits) + 1)))
+    syntax = rng.choice(('dimacs', 'lines'))
+    if syntax == 'dimacs':
+        text = 'p cnf+ %d %d\n' % (n, len(constraints)) + ''.join(
+            ' '.join(map(str, lits)) + (' 0' if kind == 'clause' else ' %s %d' % (kind, bound)) + '\n'
+            for kind, lits, bound in constraints)
+    else:
+        text = ''.join(' + '.join('x%d%s' % (abs(l), 'bar' if l < 0 else '') for l in lits)
+                       + ('' if kind == 'clause' else ' %s %d' % (kind, bound)) + '\n' for kind, lits, bound in constraints)
+    mode = modes[it % len(modes)]
+    out, err, code = run(['-q'] + mode, text)
+    expect = any(holds(values, constraints) for values in itertools.product((False, True), repeat=n))
+    if 'Satisfying assignment:' in out:
+        model = answer(out)
+        values = [model.get(v, False) for v in range(1, n + 1)]
+        failures.check(holds(values, constraints), 'formula %d %s: bad assignment' % (it, mode))
+    else:
+        failures.check('Formula is unsatisfiable.' in out and not expect, 'formula %d %s: %s %s' % (it, mode, out[-200:], err))
+
+# exactly one queen per row and column, at most one per diagonal: 6 queens have solutions
+size = 6
+cell = lambda r, c: r * size + c + 1
+lines = [[cell(r, c) for c in range(size)] for r in range(size)] + [[cell(r, c) for r in range(size)] for c in range(size)]
+diagonals = [[cell(r, r + d) for r in range(size) if 0 <= r + d < size] for d in range(-size + 2, size - 1)]
+diagonals += [[cell(r, d - r) for r in range(size) if 0 <= d - r < size] for d in range(1, 2 * size - 2)]
+text = 'p cnf+ %d 0\n' % (size * size) + ''.join(' '.join(map(str, l)) + ' >= 1\n' + ' '.join(map(str, l)) + ' <= 1\n'
+                                                for l in lines) + ''.join(' '.join(map(str, d)) + ' <= 1\n' for d in diagonals)
+out, err, code = run(['-q'], text)
+model = answer(out)
+queens = [(r, c) for r in range(size) for c in range(size) if model and model.get(cell(r, c))]
+failures.check(len(queens) == size and len({r - c for r, c in queens}) == size and len({r + c for r, c in queens}) == size,
+               'queens: bad placement %s' % queens)
+# 5 queens with the center and the four corners taken have none
+size = 5
+text = 'p cnf+ 25 0\n' + ''.join('%d 0\n' % -cell(r, c) for r, c in ((0, 0), (0, 4), (4, 0), (4, 4), (2, 2)))
+text += ''.join(' '.join(map(str, [cell(r, c) for c in range(size)])) + ' >= 1\n' for r in range(size))
+text += ''.join(' '.join(map(str, [cell(r, c) for r in range(size)])) + ' <= 1\n' for c in range(size))
+text += ''.join(' '.join(map(str, d)) + ' <= 1\n'
+                for d in [[cell(r, r + k) for r in range(size) if 0 <= r + k < size] for k in range(-3, 4)]
+                + [[cell(r, k - r) for r in range(size) if 0 <= k - r < size] for k in range(1, 8)])
+out, err, code = run(['-q'], text)
+failures.check(answer(out) is None, 'blocked queens: not refuted')
+failures.finish()
@@ -0,0 +1,59 @@
+# both input formats in single and batch mode, with variable names that start like DIMACS lines
+import random
+import re
+
+from cnfutil import *
+
+failures = Failures('formats')
+rng = random.Random(9)
+names = ['p%d' % k for k in range(1, 5)] + ['c%d' % k for k in range(1, 5)] + ['pa', 'cb', 'x1', 'x2']
+
+
+def text(clauses, syntax):
+    if syntax == 'dimacs':
+        return 'c random formula\n' + dimacs(len(names), clauses)
+    return ''.join(' + '.join(names[abs(l) - 1] + ('bar' if l < 0 else '') for l in c) + '\n' for c in clauses)
+
+
+def named(model, syntax):
+    """{variable: value} from the printed names"""
+    if syntax == 'dimacs':
+        return {int(name[1:]): value for name, value in model.items()}
+    return {names.index(name) + 1: value for name, value in model.items()}
+
+
+formulas = []
+for it in range(150):
+    n = len(names)
+    clauses = random_cnf(rng, n, rng.randint(1, 60), rng.choice((1, 2, 3)))
+    syntax = rng.choice(('dimacs', 'lines'))
+    formulas.append((clauses, syntax))
+    out, err, code = run(['-q'], text(clauses, syntax))
+    expect = brute_force(n, clauses)
+    if 'Satisfying assignment:' in out:
+        model = {}
+        for line in out.split('Satisfying assignment:\n')[1].splitlines():
+            name, value = line.split(': ')
+            model[name] = value == 'true'
+        failures.check(satisfies(named(model, syntax), clauses), 'formula %d (%s): bad assignment' % (it, syntax))
+    else:
+        failures.check('Formula is unsatisfiable.' in out and not expect,
+                       'formula %d (%s): %s %s' % (it, syntax, out[-200:], err[-200:]))
+
+# the same formulas one after the other in a batch, each file holds a single syntax
+for syntax in ('dimacs', 'lines'):
+    batch = [(c, s) for c, s in formulas if s == syntax]
+    out, err, code = run(['--batch'], ('\n' if syntax == 'lines' else '').join(text(c, s) for c, s in batch), 'batch.txt')
+    lines = [line for line in out.splitlines() if not line.startswith('c ')]
+    if not failures.check(len(lines) == len(batch), 'batch %s: %d answers for %d formulas' % (syntax, len(lines), len(batch))):
+        continue
+    for k, ((clauses, _), line) in enumerate(zip(batch, lines)):
+        match = re.match(r'^(\d+): (satisfiable|unsatisfiable)(.*)$', line)
+        if not failures.check(match and int(match.group(1)) == k + 1, 'batch %s: bad line %s' % (syntax, line)):
+            continue
+        if match.group(2) == 'unsatisfiable':
+            failures.check(not brute_force(len(names), clauses), 'batch %s formula %d: wrong unsatisfiable' % (syntax, k))
+            continue
+        model = {token[:-3] if token.endswith('bar') else token: not token.endswith('bar') for token in match.group(3).split()}
+        failures.check(satisfies(named(model, syntax), clauses), 'batch %s formula %d: bad assignment' % (syntax, k))
+failures.finish()
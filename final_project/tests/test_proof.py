@@ -0,0 +1,53 @@
+# DRAT proofs of unsatisfiable random formulas are checked for RUP, and proofs with clauses
+# longer than the proof writer's buffer must come out intact
+import random
+
+from cnfutil import *
+from drat_check import check, decode
+
+failures = Failures('proof')
+rng = random.Random(17)
+modes = [[], ['--no-preprocess'], ['--restart', 'luby'], ['--no-walk']]
+for it in range(120):
+    n = rng.randint(8, 24)
+    clauses = random_cnf(rng, n, int(n * rng.uniform(4.5, 7)), rng.choice((2, 3, 3, 4)))
+    out, err, code = run(['-q', '--proof', path('proof.drat')] + modes[it % len(modes)], dimacs(n, clauses))
+    model = answer(out)
+    if model is not None:
+        failures.check(satisfies(model, clauses), 'formula %d: assignment does not satisfy' % it)
+        continue
+    with open(path('proof.drat'), 'rb') as f:
+        result = check(clauses, f.read())
+    failures.check(result == 'ok', 'formula %d: %s' % (it, result))
+
+# mostly binary formulas go through equivalence substitution and transitive reduction
+for it in range(120):
+    n = rng.randint(6, 20)
+    clauses = random_cnf(rng, n, int(n * rng.uniform(0.8, 1.5)), 2) + random_cnf(rng, n, rng.randint(0, n), 3)
+    out, err, code = run(['-q', '--no-preprocess', '--proof', path('proof.drat')], dimacs(n, clauses))
+    model = answer(out)
+    if model is not None:
+        failures.check(satisfies(model, clauses), 'binary formula %d: assignment does not satisfy' % it)
+        continue
+    with open(path('proof.drat'), 'rb') as f:
+        result = check(clauses, f.read())
+    failures.check(result == 'ok', 'binary formula %d: %s' % (it, result))
+
+# a clause of 400000 literals, deleted by the preprocessor once the unit satisfies it
+size = 400000  # three bytes per literal, more than the 1 MiB proof buffer
+clauses = [list(range(1, size + 1)), [1]]
+out, err, code = run(['-q', '--proof', path('long.drat')], dimacs(size, clauses))
+failures.check(code == 0 and answer(out) is not None, 'long clause: solver failed: ' + err[-300:])
+with open(path('long.drat'), 'rb') as f:
+    steps = decode(f.read())
+failures.check(('d', clauses[0]) in steps, 'long clause: deletion of the long clause missing from the proof')
+
+# the same clause next to an unsatisfiable part, the proof after the long deletion must still check
+a, b = size + 1, size + 2
+clauses = [list(range(1, size + 1)), [1], [a, b], [-a, b], [a, -b], [-a, -b]]
+out, err, code = run(['-q', '--proof', path('long.drat')], dimacs(size + 2, clauses))
+failures.check(answer(out) is None, 'long unsatisfiable formula: not refuted')
+with open(path('long.drat'), 'rb') as f:
+    result = check(clauses, f.read())
+failures.check(result == 'ok', 'long unsatisfiable formula: ' + result)
+failures.finish()
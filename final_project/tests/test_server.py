@@ -0,0 +1,164 @@
+# server protocol on stdin and on a Unix socket: one-shot formulas, incremental clauses with
+# assumptions and failed-assumption cores, statistics, malformed requests and shutdown
+import os
+import random
+import socket
+import subprocess
+import threading
+import time
+
+from cnfutil import *
+
+failures = Failures('server')
+
+
+class Connection:
+    """framed requests over a pair of read and write functions"""
+    def __init__(self, read, write):
+        self.read = read
+        self.write = write
+        self.buffer = b''
+
+    def send(self, kind, payload=''):
+        payload = payload.encode()
+        self.write(('%s %d\n' % (kind, len(payload))).encode() + payload)
+
+    def receive(self):
+        while b'\n' not in self.buffer:
+            data = self.read()
+            if not data:
+                return None, ''
+            self.buffer += data
+        header, self.buffer = self.buffer.split(b'\n', 1)
+        kind, length = header.decode().split()
+        while len(self.buffer) < int(length):
+            self.buffer += self.read()
+        payload, self.buffer = self.buffer[:int(length)], self.buffer[int(length):]
+        return kind, payload.decode()
+
+    def request(self, kind, payload=''):
+        self.send(kind, payload)
+        return self.receive()
+
+
+def literals(payload):
+    return [int(token) for token in payload.split()][:-1]
+
+
+def session(connection, rng, rounds, name):
+    for it in range(rounds):
+        n = rng.randint(3, 12)
+        clauses = random_cnf(rng, n, rng.randint(n, 5 * n))
+        syntax = rng.choice(('dimacs', 'lines'))
+        text = dimacs(n, clauses) if syntax == 'dimacs' else line_syntax(clauses)
+        kind, payload = connection.request('f', text)
+        expect = brute_force(n, clauses)
+        if kind == 's':
+            model = {abs(l): l > 0 for l in literals(payload)}
+            if syntax == 'lines':
+                # x1 + x3bar variables are numbered in order of first appearance
+                order = []
+                for c in clauses:
+                    order += [abs(l) for l in c if abs(l) not in order]
+                model = {order[v - 1]: value for v, value in model.items()}
+            failures.check(satisfies(model, clauses), '%s f %d: bad model' % (name, it))
+        else:
+            failures.check(kind == 'u' and not expect, '%s f %d: %s %s' % (name, it, kind, payload))
+
+        # incremental formula growing over four queries
+        failures.check(connection.request('r') == ('o', ''), '%s r %d' % (name, it))
+        added = []
+        for step in range(4):
+            more = random_cnf(rng, n, rng.randint(1, n))
+            added += more
+            kind, payload = connection.request('a', ''.join(' '.join(map(str, c)) + ' 0\n' for c in more))
+            failures.check(kind == 'o', '%s a %d: %s %s' % (name, it, kind, payload))
+            assumptions = [v * rng.choice((1, -1)) for v in rng.sample(range(1, n + 1), rng.randint(0, 3))]
+            kind, payload = connection.request('q', ' '.join(map(str, assumptions)))
+            expect = brute_force(n, added, assumptions)
+            if kind == 's':
+                model = {abs(l): l > 0 for l in literals(payload)}
+                failures.check(expect and satisfies(model, added, assumptions), '%s q %d: bad model' % (name, it))
+            elif failures.check(kind == 'u' and not expect, '%s q %d: %s %s' % (name, it, kind, payload)):
+                core = literals(payload)
+                failures.check(set(core) <= set(assumptions) and not brute_force(n, added, core),
+                               '%s q %d: bad core %s of %s' % (name, it, core, assumptions))
+
+
+# requests on stdin, answers on stdout
+server = subprocess.Popen([SOLVER, '--server'], stdin=subprocess.PIPE, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+
+
+def write(data):
+    server.stdin.write(data)
+    server.stdin.flush()
+
+
+connection = Connection(lambda: os.read(server.stdout.fileno(), 65536), write)
+session(connection, random.Random(5), 80, 'stdio')
+kind, payload = connection.request('f', 'p cnf 2 1\n1 x 0\n')
+failures.check(kind == 'e', 'stdio: parse error answered with %s' % kind)
+kind, payload = connection.request('z')
+failures.check(kind == 'e', 'stdio: unknown request answered with %s' % kind)
+kind, payload = connection.request('t')
+failures.check(kind == 't' and 'requests=' in payload, 'stdio: statistics %s %s' % (kind, payload))
+failures.check(connection.request('x') == ('o', ''), 'stdio: stop')
+server.stdin.close()
+failures.check(server.wait(timeout=30) == 0, 'stdio: exit code %s' % server.returncode)
+
+# three clients at once on a socket
+socketPath = path('server.sock')
+server = subprocess.Popen([SOLVER, '--server', '--socket', socketPath, '--threads', '3'], stderr=subprocess.PIPE)
+while not os.path.exists(socketPath):
+    time.sleep(0.01)
+
+
+def connect():
+    client = socket.socket(socket.AF_UNIX)
+    client.connect(socketPath)
+    return client, Connection(lambda: client.recv(65536), client.sendall)
+
+
+def client(seed):
+    sock, connection = connect()
+    session(connection, random.Random(seed), 30, 'socket %d' % seed)
+    sock.close()
+
+
+clients = [threading.Thread(target=client, args=(seed,)) for seed in range(3)]
+for thread in clients:
+    thread.start()
+for thread in clients:
+    thread.join()
+# a malformed header closes only its own connection
+sock, connection = connect()
+sock.sendall(b'garbage\n')
+kind, payload = connection.receive()
+failures.check(kind == 'e', 'socket: malformed header answered with %s' % kind)
+sock.close()
+sock, connection = connect()
+failures.check(connection.request('f', 'p cnf 1 2\n1 0\n-1 0\n')[0] == 'u', 'socket: server gone after a bad client')
+failures.check(connection.request('x') == ('o', ''), 'socket: stop')
+sock.close()
+failures.check(server.wait(timeout=30) == 0, 'socket: exit code %s' % server.returncode)
+failures.check(not os.path.exists(socketPath), 'socket: socket file left behind')
+
+# a file that is not a socket is never replaced, a stale socket is
+with open(path('results.csv'), 'w') as f:
+    f.write('keep\n')
+out, err, code = run(['--server', '--socket', path('results.csv')])
+failures.check(code == 1 and open(path('results.csv')).read() == 'keep\n', 'socket: regular file replaced')
+stale = socket.socket(socket.AF_UNIX)
+stale.bind(socketPath)
+stale.close()
+server = subprocess.Popen([SOLVER, '--server', '--socket', socketPath], stderr=subprocess.PIPE)
+for _ in range(1000):
+    try:
+        sock, connection = connect()
+        break
+    except OSError:
+        time.sleep(0.01)
+failures.check(connection.request('x') == ('o', ''), 'socket: stale socket not replaced')
+sock.close()
+failures.check(server.wait(timeout=30) == 0, 'socket: exit code %s' % server.returncode)
+failures.finish()
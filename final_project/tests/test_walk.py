@@ -0,0 +1,56 @@
+# local search: standalone ProbSAT and WalkSAT on planted satisfiable formulas, bursts between
+# restarts whose assignments feed the saved phases, and no claimed model for unsatisfiable input
+import random
+import re
+
+from cnfutil import *
+
+failures = Failures('walk')
+rng = random.Random(31)
+
+
+def planted(rng, n, m):
+    """random 3-SAT clauses all satisfied by a hidden assignment"""
+    hidden = [rng.random() < 0.5 for _ in range(n + 1)]
+    clauses = []
+    while len(clauses) < m:
+        c = random_cnf(rng, n, 1)[0]
+        if any(hidden[abs(l)] == (l > 0) for l in c):
+            clauses.append(c)
+    return clauses
+
+
+for it in range(40):
+    n = rng.randint(50, 300)
+    clauses = planted(rng, n, int(n * 4.0))
+    algorithm = ('probsat', 'walksat')[it % 2]
+    out, err, code = run(['-q', '--local-search', '--walk', algorithm, '--seed', str(it)], dimacs(n, clauses))
+    # planted formulas at this density are easy, giving up counts as a failure too
+    failures.check('Satisfying assignment:' in out and satisfies(answer(out), clauses),
+                   '%s formula %d: no valid assignment %s' % (algorithm, it, err))
+
+# bursts at restarts, a high effort makes them frequent and long
+models = 0
+for it in range(30):
+    n = rng.randint(50, 200)
+    clauses = planted(rng, n, int(n * 4.2))
+    algorithm = ('probsat', 'walksat')[it % 2]
+    out, err, code = run(['--walk', algorithm, '--walk-effort', '5', '--restart', 'luby', '--luby-unit', '10'],
+                         dimacs(n, clauses))
+    failures.check(satisfies(answer(out), clauses), '%s bursts formula %d: bad assignment' % (algorithm, it))
+    match = re.search(r' walk_models=(\d+)', out)
+    models += int(match.group(1)) if match else 0
+failures.check(models > 0, 'no burst ever found a model')
+
+# the pigeonhole formula with 5 pigeons and 4 holes has no model to find
+holes = 4
+var = lambda p, h: p * holes + h + 1
+clauses = [[var(p, h) for h in range(holes)] for p in range(holes + 1)]
+clauses += [[-var(p, h), -var(q, h)] for h in range(holes) for p in range(holes + 1) for q in range(p + 1, holes + 1)]
+for algorithm in ('probsat', 'walksat'):
+    out, err, code = run(['-q', '--local-search', '--walk', algorithm, '--walk-flips', '100000'],
+                         dimacs(var(holes, holes - 1), clauses))
+    failures.check('Local search found no satisfying assignment.' in out, '%s pigeonhole: %s' % (algorithm, out[-200:]))
+    out, err, code = run(['-q', '--walk', algorithm, '--walk-effort', '5'], dimacs(var(holes, holes - 1), clauses))
+    failures.check(answer(out) is None, '%s bursts pigeonhole: not refuted' % algorithm)
+failures.finish()